@@ -0,0 +1,55 @@
+// Compile-time benchmark of exma2D/vector2D.hpp
+//
+// Instantiates every operation for 256 distinct vector classes. The
+// std::enable_if and the concepts implementations only differ in the front
+// end, so compare them without the code generation, for instance:
+//
+//     time c++ -std=c++20 -DEXMA_CONCEPTS=0 -fsyntax-only compile_time.cpp
+//     time c++ -std=c++20 -fsyntax-only compile_time.cpp
+//
+// (with the include directory added).
+//
+// The bench_compile_time_cxx14 and bench_compile_time_cxx20 targets build it
+// in full.
+
+#include "exma2D/vector2D.hpp"
+
+using namespace exma::vector;
+
+template <typename T>
+float useAll(const T & a_vector, const T & b_vector, float factor)
+{
+    const T sum = a_vector + b_vector;
+    const T difference = a_vector - b_vector;
+    const T scaled = sum * factor + factor * difference - sum / factor;
+    const T mirrored = reflect(-scaled, perpendicule(b_vector)) + 
+                       reflectN(scaled, normalize(b_vector));
+    const T projected = project(mirrored, a_vector) + 
+                        projectN(mirrored, normalize(a_vector));
+    const T rotated = rotate(projected, a_vector, Radians(factor));
+    const bool same = rotated == sum || rotated != difference;
+    return dot(rotated, a_vector) + cross(rotated, b_vector) + len2(sum) + 
+           len(scaled) + distance(a_vector, mirrored) + (same ? 1.f : 0.f);
+}
+
+#define EXMA_BENCH_VECTOR(n) \
+    struct Vector##n { float x, y; }; \
+    template float useAll(const Vector##n &, const Vector##n &, float);
+#define EXMA_BENCH_VECTORS_4(n) \
+    EXMA_BENCH_VECTOR(n##0) EXMA_BENCH_VECTOR(n##1) \
+    EXMA_BENCH_VECTOR(n##2) EXMA_BENCH_VECTOR(n##3)
+#define EXMA_BENCH_VECTORS_16(n) \
+    EXMA_BENCH_VECTORS_4(n##0) EXMA_BENCH_VECTORS_4(n##1) \
+    EXMA_BENCH_VECTORS_4(n##2) EXMA_BENCH_VECTORS_4(n##3)
+#define EXMA_BENCH_VECTORS_64(n) \
+    EXMA_BENCH_VECTORS_16(n##0) EXMA_BENCH_VECTORS_16(n##1) \
+    EXMA_BENCH_VECTORS_16(n##2) EXMA_BENCH_VECTORS_16(n##3)
+
+EXMA_BENCH_VECTORS_64(_0)
+EXMA_BENCH_VECTORS_64(_1)
+EXMA_BENCH_VECTORS_64(_2)
+EXMA_BENCH_VECTORS_64(_3)
+
+int main()
+{
+}
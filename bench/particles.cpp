@@ -0,0 +1,90 @@
+#include "exma2D/particles.hpp"
+#include "exma2D/execution.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace exma::particles;
+
+struct VectorF
+{
+    float x, y;
+};
+
+template <typename Policy, typename Step>
+double measure(const char * name, const Policy & policy, std::size_t count, 
+               int steps, Step step)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < steps; ++i)
+        step(policy);
+    const std::chrono::duration<double> elapsed = 
+        std::chrono::steady_clock::now() - start;
+
+    const auto rate = count * static_cast<double>(steps) / elapsed.count();
+    std::printf("%-24s %14.0f particles/s\n", name, rate);
+    return rate;
+}
+
+int main(int argc, const char* argv[])
+{
+    const std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) 
+                                       : 1000000;
+    const int steps = argc > 2 ? std::atoi(argv[2]) : 100;
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> distribution(-100.f, 100.f);
+    std::vector<float> x(count), y(count), vx(count), vy(count);
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        x[i] = distribution(generator);
+        y[i] = distribution(generator);
+        vx[i] = distribution(generator) / 10;
+        vy[i] = distribution(generator) / 10;
+    }
+
+    const wall<VectorF> box[] = {
+        {{1, 0}, -100}, {{-1, 0}, -100}, {{0, 1}, -100}, {{0, -1}, -100}
+    };
+    integration_parameters<VectorF> parameters;
+    parameters.dt = 1.f / 60;
+    parameters.gravity = {0.f, -9.81f};
+    parameters.drag = .1f;
+    parameters.max_speed = 50.f;
+    parameters.walls = box;
+    parameters.wall_count = 4;
+
+    std::printf("%zu particles, %d steps\n", count, steps);
+
+    particle_arrays<float> euler{x.data(), y.data(), vx.data(), vy.data(), 
+                                 count};
+    auto integrate_euler = [&](const auto & policy)
+    {
+        integrateEuler(policy, euler, parameters);
+    };
+    measure("euler, sequenced", exma::execution::seq, count, steps, 
+            integrate_euler);
+    measure("euler, parallel", exma::execution::par, count, steps, 
+            integrate_euler);
+
+    // Previous positions are derived from the velocities
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        vx[i] = x[i] - vx[i] * parameters.dt;
+        vy[i] = y[i] - vy[i] * parameters.dt;
+    }
+    verlet_arrays<float> verlet{x.data(), y.data(), vx.data(), vy.data(), 
+                                count};
+    auto integrate_verlet = [&](const auto & policy)
+    {
+        integrateVerlet(policy, verlet, parameters);
+    };
+    measure("verlet, sequenced", exma::execution::seq, count, steps, 
+            integrate_verlet);
+    measure("verlet, parallel", exma::execution::par, count, steps, 
+            integrate_verlet);
+}
@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// ExMa2D - tiny EXternal MAth library for 2D
+// Copyright (c) 2016 Levi Taule
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef EXECUTION_HPP
+#define EXECUTION_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+/// @file
+
+namespace exma {
+
+/// @brief Execution policies for the batch functions
+/// @details Batch functions take one of these as their first argument, 
+/// similarly to the C++17 parallel algorithms. For instance:
+/// @code
+/// auto simplified = simplifyRDP(exma::execution::par, tracks, 0.5f);
+/// @endcode
+
+namespace execution {
+
+/// @brief Runs the whole batch on the calling thread
+struct sequenced_policy {};
+
+/// @brief Splits the batch among several threads
+/// @details
+/// The calling thread takes part in the work as well, so with **threads** 
+/// set to 4 only 3 additional threads are spawned.
+struct parallel_policy
+{
+    /// Number of threads to use, `0` means 
+    /// `std::thread::hardware_concurrency()`
+    unsigned int threads;
+};
+
+constexpr sequenced_policy seq{};
+constexpr parallel_policy par{0};
+
+/// @brief Answers if **P** is one of the execution policies
+template <typename P>
+struct is_execution_policy : std::false_type {};
+
+template <>
+struct is_execution_policy<sequenced_policy> : std::true_type {};
+
+template <>
+struct is_execution_policy<parallel_policy> : std::true_type {};
+
+/// @brief Calls **function** on consecutive index ranges covering 
+/// `[0, count)`
+/// @details
+/// The ranges are at most **grain** indices long and they are handed out 
+/// dynamically, so the threads which finish early take over the rest of the 
+/// work. **function** is called as `function(begin, end)` and must be safe 
+/// to call concurrently for disjoint ranges.
+///
+/// @param policy
+/// @param count
+/// Number of indices to process
+/// @param grain
+/// Maximal length of a single range, `0` is treated as `1`
+/// @param function
+template <typename F>
+void forEachRange(sequenced_policy policy, std::size_t count, 
+                  std::size_t grain, F && function);
+
+/// @copydoc forEachRange(sequenced_policy, std::size_t, std::size_t, F &&)
+template <typename F>
+void forEachRange(parallel_policy policy, std::size_t count, 
+                  std::size_t grain, F && function);
+
+}
+}
+
+#include "impl/execution.tpp"
+
+#endif
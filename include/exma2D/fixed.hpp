@@ -0,0 +1,558 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// ExMa2D - tiny EXternal MAth library for 2D
+// Copyright (c) 2016 Levi Taule
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef FIXED_HPP
+#define FIXED_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include "vector2D.hpp"
+#include "execution.hpp"
+#include "impl/utils.tpp"
+
+/// @file
+
+namespace exma {
+
+/// @brief Fixed-point numbers for deterministic computations
+/// @details The numbers are plain integers underneath, so every operation 
+/// yields bit-identical results on every machine, which floating-point 
+/// numbers don't guarantee. They work as components of your vector class with 
+/// all the exma::vector functions. For instance:
+/// @code
+/// struct VectorQ
+/// {
+///     exma::fixed::q16_16 x, y;
+/// };
+///
+/// auto turned = rotate(VectorQ{3, 4}, VectorQ{0, 0}, 90_deg);
+/// @endcode
+/// The integers convert to them implicitly, the floating-point numbers only 
+/// explicitly, so that they don't sneak into the computations by accident.
+/// The operations don't check for overflows, in particular the squared 
+/// length of a q16_16 vector overflows once the length exceeds 181. Instead 
+/// they wrap around, the same way on every machine, as long as the numbers 
+/// converted from floating-point ones are in range.
+
+namespace fixed {
+
+/// @brief A signed fixed-point number with **Fraction** fractional bits, 
+/// stored in **Storage**
+template <int Fraction, typename Storage>
+class fixed_point;
+
+template <typename Storage>
+struct wider;
+
+template <>
+struct wider<std::int32_t>
+{
+    using type = std::int64_t;
+    using unsigned_type = std::uint64_t;
+};
+
+#ifdef __SIZEOF_INT128__
+template <>
+struct wider<std::int64_t>
+{
+    // __extension__ keeps -Wpedantic quiet about the non-standard type
+    __extension__ typedef __int128 type;
+    __extension__ typedef unsigned __int128 unsigned_type;
+};
+#endif
+
+template <int Fraction, typename Storage>
+class fixed_point
+{
+    using wide = typename wider<Storage>::type;
+    using unsigned_wide = typename wider<Storage>::unsigned_type;
+    // Overflowing computations are done in the unsigned type, so that they 
+    // wrap around the same way everywhere instead of being undefined
+    using unsigned_storage = std::make_unsigned_t<Storage>;
+
+    static_assert(std::is_signed<Storage>::value, 
+                  "Storage must be a signed integer");
+    static_assert(Fraction > 0 && 
+                  Fraction < std::numeric_limits<Storage>::digits, 
+                  "Storage must fit the fractional bits and the sign");
+
+public:
+    using storage_type = Storage;
+    static constexpr int fraction_bits = Fraction;
+    static constexpr Storage one = Storage{1} << Fraction;
+
+    constexpr fixed_point() :
+        m_raw(0)
+    {}
+
+    template <
+      typename I,
+      typename = std::enable_if_t<std::is_integral<I>::value>>
+    constexpr fixed_point(I integer) :
+        m_raw(static_cast<Storage>(static_cast<unsigned_storage>(integer) * 
+                                   static_cast<unsigned_storage>(one)))
+    {}
+
+    /// Rounds to the nearest representable number
+    template <
+      typename R,
+      typename = std::enable_if_t<std::is_floating_point<R>::value>,
+      typename = void>
+    constexpr explicit fixed_point(R real) :
+        m_raw(static_cast<Storage>(
+            static_cast<double>(real) * one + (real < 0 ? -.5 : .5)))
+    {}
+
+    /// @brief Creates the number from its underlying integer
+    static constexpr fixed_point fromRaw(Storage raw)
+    {
+        fixed_point number;
+        number.m_raw = raw;
+        return number;
+    }
+
+    /// @brief The underlying integer, that is the number times 
+    /// `2^fraction_bits`
+    constexpr Storage raw() const
+    {
+        return m_raw;
+    }
+
+    template <
+      typename R,
+      typename = std::enable_if_t<std::is_floating_point<R>::value>>
+    constexpr explicit operator R() const
+    {
+        return static_cast<R>(m_raw) / one;
+    }
+
+    friend constexpr fixed_point operator+(fixed_point a, fixed_point b)
+    {
+        return fromRaw(static_cast<Storage>(
+            static_cast<unsigned_storage>(a.m_raw) + 
+            static_cast<unsigned_storage>(b.m_raw)));
+    }
+
+    friend constexpr fixed_point operator-(fixed_point a, fixed_point b)
+    {
+        return fromRaw(static_cast<Storage>(
+            static_cast<unsigned_storage>(a.m_raw) - 
+            static_cast<unsigned_storage>(b.m_raw)));
+    }
+
+    friend constexpr fixed_point operator-(fixed_point a)
+    {
+        return fromRaw(static_cast<Storage>(
+            unsigned_storage{0} - static_cast<unsigned_storage>(a.m_raw)));
+    }
+
+    /// Rounds to the nearest representable number
+    friend constexpr fixed_point operator*(fixed_point a, fixed_point b)
+    {
+        return fromRaw(static_cast<Storage>(
+            (static_cast<wide>(a.m_raw) * b.m_raw + (one >> 1)) >> Fraction));
+    }
+
+    /// Rounds towards zero, dividing by zero is undefined
+    friend constexpr fixed_point operator/(fixed_point a, fixed_point b)
+    {
+        return fromRaw(static_cast<Storage>(
+            static_cast<wide>(a.m_raw) * one / b.m_raw));
+    }
+
+    friend constexpr bool operator==(fixed_point a, fixed_point b)
+    {
+        return a.m_raw == b.m_raw;
+    }
+
+    friend constexpr bool operator!=(fixed_point a, fixed_point b)
+    {
+        return a.m_raw != b.m_raw;
+    }
+
+    friend constexpr bool operator<(fixed_point a, fixed_point b)
+    {
+        return a.m_raw < b.m_raw;
+    }
+
+    friend constexpr bool operator<=(fixed_point a, fixed_point b)
+    {
+        return a.m_raw <= b.m_raw;
+    }
+
+    friend constexpr bool operator>(fixed_point a, fixed_point b)
+    {
+        return a.m_raw > b.m_raw;
+    }
+
+    friend constexpr bool operator>=(fixed_point a, fixed_point b)
+    {
+        return a.m_raw >= b.m_raw;
+    }
+
+    friend constexpr fixed_point abs(fixed_point a)
+    {
+        return a.m_raw < 0 ? -a : a;
+    }
+
+    /// Rounds down, the root of a negative number is zero
+    friend constexpr fixed_point sqrt(fixed_point a)
+    {
+        if(a.m_raw <= 0)
+            return fixed_point{};
+
+        // Digit by digit, the root of raw * 2^Fraction is the raw root
+        auto remainder = static_cast<unsigned_wide>(a.m_raw) << Fraction;
+        unsigned_wide root = 0;
+        unsigned_wide bit = unsigned_wide{1} << (sizeof(unsigned_wide) * 8 - 2);
+        while(bit > remainder)
+            bit >>= 2;
+        while(bit != 0)
+        {
+            if(remainder >= root + bit)
+            {
+                remainder -= root + bit;
+                root = (root >> 1) + bit;
+            }
+            else
+                root >>= 1;
+            bit >>= 2;
+        }
+        return fromRaw(static_cast<Storage>(root));
+    }
+
+    // Lets exma::utils::compare() measure the tolerance in ULPs
+    friend constexpr std::intmax_t ulpsOrdinal(fixed_point a)
+    {
+        return a.m_raw;
+    }
+
+private:
+    Storage m_raw;
+};
+
+template <int Fraction, typename Storage>
+constexpr int fixed_point<Fraction, Storage>::fraction_bits;
+
+template <int Fraction, typename Storage>
+constexpr Storage fixed_point<Fraction, Storage>::one;
+
+/// @brief Q16.16, that is 16 integer bits (with the sign) and 16 fractional 
+/// bits, the range is about `[-32768, 32768)`
+using q16_16 = fixed_point<16, std::int32_t>;
+
+#ifdef __SIZEOF_INT128__
+/// @brief Q32.32, that is 32 integer bits (with the sign) and 32 fractional 
+/// bits, the range is about `[-2^31, 2^31)`
+/// @details
+/// Only available with compilers which have a 128-bit integer 
+/// (`__int128`) for the intermediate results.
+using q32_32 = fixed_point<32, std::int64_t>;
+#endif
+
+/// @brief Finds out the sine of **angle** in radians
+/// @details
+/// Computed by CORDIC in 64-bit integers, so the result is the same on every 
+/// machine. It is precise to the last bit of **angle**'s type.
+///
+/// @param angle
+///
+/// @return
+/// The sine of **angle**
+template <int Fraction, typename Storage>
+fixed_point<Fraction, Storage> sin(fixed_point<Fraction, Storage> angle);
+
+/// @brief Finds out the cosine of **angle** in radians
+/// @details
+/// Computed by CORDIC in 64-bit integers, so the result is the same on every 
+/// machine. It is precise to the last bit of **angle**'s type.
+///
+/// @param angle
+///
+/// @return
+/// The cosine of **angle**
+template <int Fraction, typename Storage>
+fixed_point<Fraction, Storage> cos(fixed_point<Fraction, Storage> angle);
+
+/// @brief Components of vectors stored as structure of arrays, used by the 
+/// batch functions
+template <typename F>
+struct vector_arrays
+{
+    F * x;
+    F * y;
+    std::size_t count;
+};
+
+/// @brief Moves all the vectors by **offset**
+/// @details
+/// Like the rest of the batch functions, it is written for the compiler to 
+/// vectorize it. For q16_16 all three stay in 32-bit integer lanes, even the 
+/// multiplications, so they vectorize at `-O3` with plain SSE2. The batch 
+/// functions work on arithmetic components too.
+///
+/// @param policy
+/// exma::execution::seq or exma::execution::par
+/// @param vectors
+/// @param offset
+template <typename Policy, typename T, typename, typename>
+void translate(const Policy & policy, 
+    const vector_arrays<decltype(std::declval<T>().x)> & vectors, 
+    const T & offset);
+
+/// @brief Multiplies all the vectors by **factor**
+///
+/// @param policy
+/// exma::execution::seq or exma::execution::par
+/// @param vectors
+/// @param factor
+template <typename Policy, typename F, typename, typename>
+void scale(const Policy & policy, const vector_arrays<F> & vectors, 
+           const F factor);
+
+/// @brief Rotates all the vectors around **origin**, the same way as 
+/// exma::vector::rotate() does
+/// @details
+/// The sine and the cosine are computed just once for all the vectors.
+///
+/// @param policy
+/// exma::execution::seq or exma::execution::par
+/// @param vectors
+/// @param origin
+/// @param angle
+template <typename Policy, typename T, typename, typename>
+void rotate(const Policy & policy, 
+    const vector_arrays<decltype(std::declval<T>().x)> & vectors, 
+    const T & origin, Radians angle);
+
+}
+
+namespace utils {
+
+template <int Fraction, typename Storage>
+struct is_number<exma::fixed::fixed_point<Fraction, Storage>> : 
+    std::true_type {};
+
+template <int Fraction, typename Storage>
+struct trigonometry<exma::fixed::fixed_point<Fraction, Storage>>
+{
+    using number = exma::fixed::fixed_point<Fraction, Storage>;
+
+    static number cos(double angle)
+    {
+        return exma::fixed::cos(number{angle});
+    }
+
+    static number sin(double angle)
+    {
+        return exma::fixed::sin(number{angle});
+    }
+};
+
+}
+}
+
+namespace std {
+
+template <int Fraction, typename Storage>
+class numeric_limits<exma::fixed::fixed_point<Fraction, Storage>>
+{
+    using number = exma::fixed::fixed_point<Fraction, Storage>;
+
+public:
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed = true;
+    static constexpr bool is_integer = false;
+    static constexpr bool is_exact = true;
+    static constexpr bool has_infinity = false;
+    static constexpr bool has_quiet_NaN = false;
+    static constexpr bool has_signaling_NaN = false;
+    static constexpr float_denorm_style has_denorm = denorm_absent;
+    static constexpr bool has_denorm_loss = false;
+    // Multiplication rounds to the nearest, division towards zero
+    static constexpr float_round_style round_style = round_indeterminate;
+    static constexpr bool is_iec559 = false;
+    static constexpr bool is_bounded = true;
+    static constexpr bool is_modulo = false;
+    static constexpr int digits = numeric_limits<Storage>::digits;
+    static constexpr int digits10 = numeric_limits<Storage>::digits10;
+    // Same formula as for the floating-point types
+    static constexpr int max_digits10 = 2 + digits * 30103 / 100000;
+    static constexpr int radix = 2;
+    static constexpr int min_exponent = 0;
+    static constexpr int min_exponent10 = 0;
+    static constexpr int max_exponent = 0;
+    static constexpr int max_exponent10 = 0;
+    static constexpr bool traps = numeric_limits<Storage>::traps;
+    static constexpr bool tinyness_before = false;
+
+    /// Smallest positive number, as for the floating-point types
+    static constexpr number min()
+    {
+        return epsilon();
+    }
+
+    static constexpr number lowest()
+    {
+        return number::fromRaw(numeric_limits<Storage>::min());
+    }
+
+    static constexpr number max()
+    {
+        return number::fromRaw(numeric_limits<Storage>::max());
+    }
+
+    static constexpr number epsilon()
+    {
+        return number::fromRaw(1);
+    }
+
+    // Division may be off by a whole epsilon
+    static constexpr number round_error()
+    {
+        return epsilon();
+    }
+
+    // Like for integers, there's no NaN, so these are zero
+    static constexpr number infinity()
+    {
+        return number{};
+    }
+
+    static constexpr number quiet_NaN()
+    {
+        return number{};
+    }
+
+    static constexpr number signaling_NaN()
+    {
+        return number{};
+    }
+
+    static constexpr number denorm_min()
+    {
+        return min();
+    }
+};
+
+template <int Fraction, typename Storage>
+constexpr bool 
+numeric_limits<exma::fixed::fixed_point<Fraction, Storage>>::is_specialized;
+
+template <int Fraction, typename Storage>
+constexpr bool 
+numeric_limits<exma::fixed::fixed_point<Fraction, Storage>>::is_signed;
+
+template <int Fraction, typename Storage>
+constexpr bool 
+numeric_limits<exma::fixed::fixed_point<Fraction, Storage>>::is_integer;
+
+template <int Fraction, typename Storage>
+constexpr bool 
+numeric_limits<exma::fixed::fixed_point<Fraction, Storage>>::is_exact;
+
+template <int Fraction, typename Storage>
+constexpr bool 
+numeric_limits<exma::fixed::fixed_point<Fraction, Storage>>::has_infinity;
+
+template <int Fraction, typename Storage>
+constexpr bool 
+numeric_limits<exma::fixed::fixed_point<Fraction, Storage>>::has_quiet_NaN;
+
+template <int Fraction, typename Storage>
+constexpr bool 
+numeric_limits<exma::fixed::fixed_point<Fraction, Storage>>::has_signaling_NaN;
+
+template <int Fraction, typename Storage>
+constexpr float_denorm_style 
+numeric_limits<exma::fixed::fixed_point<Fraction, Storage>>::has_denorm;
+
+template <int Fraction, typename Storage>
+constexpr bool 
+numeric_limits<exma::fixed::fixed_point<Fraction, Storage>>::has_denorm_loss;
+
+template <int Fraction, typename Storage>
+constexpr float_round_style 
+numeric_limits<exma::fixed::fixed_point<Fraction, Storage>>::round_style;
+
+template <int Fraction, typename Storage>
+constexpr bool 
+numeric_limits<exma::fixed::fixed_point<Fraction, Storage>>::is_iec559;
+
+template <int Fraction, typename Storage>
+constexpr bool 
+numeric_limits<exma::fixed::fixed_point<Fraction, Storage>>::is_bounded;
+
+template <int Fraction, typename Storage>
+constexpr bool 
+numeric_limits<exma::fixed::fixed_point<Fraction, Storage>>::is_modulo;
+
+template <int Fraction, typename Storage>
+constexpr int 
+numeric_limits<exma::fixed::fixed_point<Fraction, Storage>>::digits;
+
+template <int Fraction, typename Storage>
+constexpr int 
+numeric_limits<exma::fixed::fixed_point<Fraction, Storage>>::digits10;
+
+template <int Fraction, typename Storage>
+constexpr int 
+numeric_limits<exma::fixed::fixed_point<Fraction, Storage>>::max_digits10;
+
+template <int Fraction, typename Storage>
+constexpr int 
+numeric_limits<exma::fixed::fixed_point<Fraction, Storage>>::radix;
+
+template <int Fraction, typename Storage>
+constexpr int 
+numeric_limits<exma::fixed::fixed_point<Fraction, Storage>>::min_exponent;
+
+template <int Fraction, typename Storage>
+constexpr int 
+numeric_limits<exma::fixed::fixed_point<Fraction, Storage>>::min_exponent10;
+
+template <int Fraction, typename Storage>
+constexpr int 
+numeric_limits<exma::fixed::fixed_point<Fraction, Storage>>::max_exponent;
+
+template <int Fraction, typename Storage>
+constexpr int 
+numeric_limits<exma::fixed::fixed_point<Fraction, Storage>>::max_exponent10;
+
+template <int Fraction, typename Storage>
+constexpr bool 
+numeric_limits<exma::fixed::fixed_point<Fraction, Storage>>::traps;
+
+template <int Fraction, typename Storage>
+constexpr bool 
+numeric_limits<exma::fixed::fixed_point<Fraction, Storage>>::tinyness_before;
+
+}
+
+#include "impl/fixed.tpp"
+
+#endif
@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// ExMa2D - tiny EXternal MAth library for 2D
+// Copyright (c) 2016 Levi Taule
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef EXECUTION_CPP
+#define EXECUTION_CPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include "../execution.hpp"
+
+namespace exma { namespace execution {
+
+template <typename F>
+void forEachRange(sequenced_policy, std::size_t count, std::size_t grain, 
+                  F && function)
+{
+    if(grain == 0)
+        grain = 1;
+    std::size_t begin = 0;
+    while(begin < count)
+    {
+        const auto end = begin + std::min(grain, count - begin);
+        function(begin, end);
+        begin = end;
+    }
+}
+
+template <typename F>
+void forEachRange(parallel_policy policy, std::size_t count, 
+                  std::size_t grain, F && function)
+{
+    if(grain == 0)
+        grain = 1;
+
+    std::size_t threads = policy.threads;
+    if(threads == 0)
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    threads = std::min(threads, (count + grain - 1) / grain);
+
+    if(threads <= 1)
+    {
+        forEachRange(seq, count, grain, function);
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    auto work = [&]()
+    {
+        for(;;)
+        {
+            const auto begin = next.fetch_add(grain);
+            if(begin >= count)
+                return;
+            function(begin, std::min(begin + grain, count));
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for(std::size_t i = 1; i < threads; ++i)
+        workers.emplace_back(work);
+    work();
+    for(auto & worker : workers)
+        worker.join();
+}
+
+}}
+#endif
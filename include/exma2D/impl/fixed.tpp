@@ -0,0 +1,276 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// ExMa2D - tiny EXternal MAth library for 2D
+// Copyright (c) 2016 Levi Taule
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef FIXED_CPP
+#define FIXED_CPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "../fixed.hpp"
+#include "../execution.hpp"
+#include "../instrument.hpp"
+
+namespace exma { namespace fixed {
+
+// CORDIC works with 61 fractional bits, which leaves room for the sign and
+// for the vector growing up to 1.65 during the iterations
+constexpr int cordic_bits = 61;
+constexpr std::int64_t cordic_half_pi = 3622009729038561421;
+// Inverse of the gain of all the iterations
+constexpr std::int64_t cordic_gain = 1400229935014726477;
+// atan(2^-i)
+constexpr std::int64_t cordic_atan[cordic_bits] = {
+    1811004864519280711, 1069098597953152948, 564882337777596249,
+    286743094836456889, 143927976672616092, 72034151524184357,
+    36025865417378411, 18014032019027246, 9007153442175927,
+    4503593900760542, 2251799097857775, 1125899817364151,
+    562949942236502, 281474975312555, 140737488180565,
+    70368744155819, 35184372086101, 17592186044075,
+    8796093022165, 4398046511099, 2199023255551,
+    1099511627776, 549755813888, 274877906944,
+    137438953472, 68719476736, 34359738368,
+    17179869184, 8589934592, 4294967296,
+    2147483648, 1073741824, 536870912,
+    268435456, 134217728, 67108864,
+    33554432, 16777216, 8388608,
+    4194304, 2097152, 1048576,
+    524288, 262144, 131072,
+    65536, 32768, 16384,
+    8192, 4096, 2048,
+    1024, 512, 256,
+    128, 64, 32,
+    16, 8, 4,
+    2
+};
+
+struct sine_cosine
+{
+    std::int64_t sine, cosine;
+};
+
+// Sine and cosine of the angle with the given number of fractional bits,
+// both with cordic_bits fractional bits
+inline sine_cosine cordic(std::int64_t angle, int fraction)
+{
+    const int shift = cordic_bits - fraction;
+    const std::int64_t half_pi = cordic_half_pi >> shift;
+    // What got shifted out of half_pi
+    const std::int64_t half_pi_rest = cordic_half_pi - half_pi * 
+        (std::int64_t{1} << shift);
+
+    // The angle is reduced to [-pi/4, pi/4] by whole quarter-turns, which 
+    // are applied afterwards by swapping and negating
+    const std::int64_t quarters = (angle + (angle < 0 ? -half_pi : half_pi) / 2)
+        / half_pi;
+    std::int64_t z = (angle - quarters * half_pi) * (std::int64_t{1} << shift) 
+        - quarters * half_pi_rest;
+
+    std::int64_t x = cordic_gain;
+    std::int64_t y = 0;
+    for(int i = 0; i < cordic_bits; ++i)
+    {
+        const std::int64_t x_shifted = x >> i;
+        const std::int64_t y_shifted = y >> i;
+        if(z >= 0)
+        {
+            x -= y_shifted;
+            y += x_shifted;
+            z -= cordic_atan[i];
+        }
+        else
+        {
+            x += y_shifted;
+            y -= x_shifted;
+            z += cordic_atan[i];
+        }
+    }
+
+    switch(((quarters % 4) + 4) % 4)
+    {
+    case 0:
+        return {y, x};
+    case 1:
+        return {x, -y};
+    case 2:
+        return {-y, -x};
+    default:
+        return {-x, y};
+    }
+}
+
+// Rounds a number with cordic_bits fractional bits to the fixed-point type
+template <int Fraction, typename Storage>
+fixed_point<Fraction, Storage> fromCordic(std::int64_t value)
+{
+    const int shift = cordic_bits - Fraction;
+    return fixed_point<Fraction, Storage>::fromRaw(static_cast<Storage>(
+        (value + (std::int64_t{1} << (shift - 1))) >> shift));
+}
+
+template <int Fraction, typename Storage>
+fixed_point<Fraction, Storage> sin(fixed_point<Fraction, Storage> angle)
+{
+    return fromCordic<Fraction, Storage>(cordic(angle.raw(), Fraction).sine);
+}
+
+template <int Fraction, typename Storage>
+fixed_point<Fraction, Storage> cos(fixed_point<Fraction, Storage> angle)
+{
+    return fromCordic<Fraction, Storage>(cordic(angle.raw(), Fraction).cosine);
+}
+
+// The batch functions accept arithmetic components as well
+template <
+  typename A,
+  typename B,
+  typename = std::enable_if_t<std::is_arithmetic<A>::value>,
+  typename = std::enable_if_t<std::is_arithmetic<B>::value>>
+constexpr auto batchMultiply(A a, B b) -> decltype(a * b)
+{
+    return a * b;
+}
+
+// Same as a * b, used by the batch functions. The generic version widens
+// the product, which for 32-bit storage means 64-bit lanes: only AVX2 
+// multiplies those in a vector.
+template <int Fraction, typename Storage>
+constexpr fixed_point<Fraction, Storage> batchMultiply(
+    fixed_point<Fraction, Storage> a, fixed_point<Fraction, Storage> b)
+{
+    return a * b;
+}
+
+// With 32-bit storage the factors are split into their integral and their
+// fractional part instead, so that all the partial products stay in 32-bit
+// lanes, which plain SSE2 can multiply. The result is the same bit for bit,
+// as the parts are exact and the unsigned arithmetic wraps the same way.
+template <
+  int Fraction,
+  typename = std::enable_if_t<(Fraction <= 16)>>
+constexpr fixed_point<Fraction, std::int32_t> batchMultiply(
+    fixed_point<Fraction, std::int32_t> a, 
+    fixed_point<Fraction, std::int32_t> b)
+{
+    constexpr std::uint32_t mask = (std::uint32_t{1} << Fraction) - 1;
+    constexpr std::uint32_t half = std::uint32_t{1} << (Fraction - 1);
+    const auto a_high = static_cast<std::uint32_t>(a.raw() >> Fraction);
+    const auto b_high = static_cast<std::uint32_t>(b.raw() >> Fraction);
+    const auto a_low = static_cast<std::uint32_t>(a.raw()) & mask;
+    const auto b_low = static_cast<std::uint32_t>(b.raw()) & mask;
+    return fixed_point<Fraction, std::int32_t>::fromRaw(
+        static_cast<std::int32_t>(
+            (a_high * b_high << Fraction) + a_high * b_low + a_low * b_high + 
+            ((a_low * b_low + half) >> Fraction)));
+}
+
+template <
+  typename Policy,
+  typename T,
+  typename = 
+    std::enable_if_t<exma::execution::is_execution_policy<Policy>{}>,
+  typename = 
+    std::enable_if_t<exma::utils::is_number<decltype(std::declval<T>().x)>{}>>
+void translate(const Policy & policy, 
+    const vector_arrays<decltype(std::declval<T>().x)> & vectors, 
+    const T & offset)
+{
+    EXMA_INSTRUMENT_TIME(instrument::function::fixed_translate);
+    const auto offset_x = offset.x;
+    const auto offset_y = offset.y;
+    exma::execution::forEachRange(policy, vectors.count, 4096,
+        [&](std::size_t begin, std::size_t end)
+        {
+            auto * const x = vectors.x;
+            auto * const y = vectors.y;
+            for(auto i = begin; i < end; ++i)
+            {
+                x[i] = x[i] + offset_x;
+                y[i] = y[i] + offset_y;
+            }
+        });
+}
+
+template <
+  typename Policy,
+  typename F,
+  typename = 
+    std::enable_if_t<exma::execution::is_execution_policy<Policy>{}>,
+  typename = std::enable_if_t<exma::utils::is_number<F>{}>>
+void scale(const Policy & policy, const vector_arrays<F> & vectors, 
+           const F factor)
+{
+    EXMA_INSTRUMENT_TIME(instrument::function::fixed_scale);
+    exma::execution::forEachRange(policy, vectors.count, 4096,
+        [&](std::size_t begin, std::size_t end)
+        {
+            auto * const x = vectors.x;
+            auto * const y = vectors.y;
+            for(auto i = begin; i < end; ++i)
+            {
+                x[i] = batchMultiply(x[i], factor);
+                y[i] = batchMultiply(y[i], factor);
+            }
+        });
+}
+
+template <
+  typename Policy,
+  typename T,
+  typename = 
+    std::enable_if_t<exma::execution::is_execution_policy<Policy>{}>,
+  typename = 
+    std::enable_if_t<exma::utils::is_number<decltype(std::declval<T>().x)>{}>>
+void rotate(const Policy & policy, 
+    const vector_arrays<decltype(std::declval<T>().x)> & vectors, 
+    const T & origin, Radians angle)
+{
+    EXMA_INSTRUMENT_TIME(instrument::function::fixed_rotate);
+    using trigonometry = 
+        exma::utils::trigonometry<decltype(std::declval<T>().x)>;
+    const auto cr = trigonometry::cos(angle.getValue());
+    const auto sr = trigonometry::sin(angle.getValue());
+    const auto origin_x = origin.x;
+    const auto origin_y = origin.y;
+
+    exma::execution::forEachRange(policy, vectors.count, 4096,
+        [&](std::size_t begin, std::size_t end)
+        {
+            auto * const x = vectors.x;
+            auto * const y = vectors.y;
+            for(auto i = begin; i < end; ++i)
+            {
+                const auto dx = x[i] - origin_x;
+                const auto dy = y[i] - origin_y;
+                x[i] = origin_x + 
+                    (batchMultiply(dx, cr) - batchMultiply(dy, sr));
+                y[i] = origin_y + 
+                    (batchMultiply(dx, sr) + batchMultiply(dy, cr));
+            }
+        });
+}
+
+}}
+#endif
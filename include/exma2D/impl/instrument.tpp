@@ -0,0 +1,235 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// ExMa2D - tiny EXternal MAth library for 2D
+// Copyright (c) 2016 Levi Taule
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INSTRUMENT_CPP
+#define INSTRUMENT_CPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "../instrument.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#endif
+
+namespace exma { namespace instrument {
+
+constexpr std::size_t function_count = 
+    static_cast<std::size_t>(function::count);
+
+constexpr const char * function_names[function_count] = {
+    "operator+", "operator-", "operator*", "operator/", "operator==", 
+    "operator!=", "operator- (unary)", "perpendicule", "dot", "cross", 
+    "len2", "len", "distance", "normalize", "project", "projectN", "reflect", 
+    "reflectN", "rotate", "segmentDistance2", "simplifyRDP", "simplifyVW", 
+    "weld", "integrateEuler", "integrateVerlet", "fixed::translate", 
+    "fixed::scale", "fixed::rotate"
+};
+
+// Counters of one thread. Only the owning thread writes them, so a relaxed
+// load and store suffice and other threads can still read them safely.
+struct counters
+{
+    std::atomic<std::uint64_t> calls[function_count];
+    std::atomic<std::uint64_t> samples[function_count];
+    std::atomic<std::uint64_t> ticks[function_count];
+    // Whether a running thread owns the counters
+    std::atomic<bool> taken;
+    counters * next;
+};
+
+inline void increase(std::atomic<std::uint64_t> & counter, std::uint64_t by)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + by, 
+                  std::memory_order_relaxed);
+}
+
+// Head of the list of the counters of all the threads, which ever called
+// an instrumented function
+inline std::atomic<counters *> & registry()
+{
+    static std::atomic<counters *> head{nullptr};
+    return head;
+}
+
+// Takes over the counters left by a finished thread, or adds new ones, so 
+// that the registry only grows with the number of concurrent threads
+inline counters * claim()
+{
+    auto & head = registry();
+    for(auto * thread = head.load(std::memory_order_acquire); 
+        thread != nullptr; thread = thread->next)
+    {
+        bool taken = false;
+        if(!thread->taken.load(std::memory_order_relaxed) &&
+           thread->taken.compare_exchange_strong(taken, true, 
+                                                 std::memory_order_acquire,
+                                                 std::memory_order_relaxed))
+            return thread;
+    }
+
+    auto * created = new counters{};
+    created->taken.store(true, std::memory_order_relaxed);
+    created->next = head.load(std::memory_order_relaxed);
+    while(!head.compare_exchange_weak(created->next, created, 
+                                      std::memory_order_release,
+                                      std::memory_order_relaxed))
+        ;
+    return created;
+}
+
+// Releases the counters of the thread when it exits. They keep their 
+// values, so that they can still be dumped, and the next owner adds to them.
+struct owner
+{
+    counters * const mine = claim();
+
+    ~owner()
+    {
+        mine->taken.store(false, std::memory_order_release);
+    }
+};
+
+inline counters & local()
+{
+    thread_local owner thread;
+    return *thread.mine;
+}
+
+inline std::uint64_t ticks()
+{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+    defined(_M_IX86)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(
+        std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+inline void count(function id)
+{
+    increase(local().calls[static_cast<std::size_t>(id)], 1);
+}
+
+inline timer::timer(function id) :
+    m_id(id),
+    m_sampled(false),
+    m_start(0)
+{
+    auto & calls = local().calls[static_cast<std::size_t>(id)];
+    const auto previous = calls.load(std::memory_order_relaxed);
+    calls.store(previous + 1, std::memory_order_relaxed);
+    if((previous & (EXMA_INSTRUMENT_SAMPLING - 1)) == 0)
+    {
+        m_sampled = true;
+        m_start = ticks();
+    }
+}
+
+inline timer::~timer()
+{
+    if(!m_sampled)
+        return;
+    const auto elapsed = ticks() - m_start;
+    auto & mine = local();
+    increase(mine.samples[static_cast<std::size_t>(m_id)], 1);
+    increase(mine.ticks[static_cast<std::size_t>(m_id)], elapsed);
+}
+
+inline std::vector<function_stats> snapshot()
+{
+    std::vector<function_stats> stats;
+    for(std::size_t i = 0; i < function_count; ++i)
+        stats.push_back({function_names[i], 0, 0, 0});
+
+    for(auto * thread = registry().load(std::memory_order_acquire); 
+        thread != nullptr; thread = thread->next)
+    {
+        for(std::size_t i = 0; i < function_count; ++i)
+        {
+            stats[i].calls += thread->calls[i].load(std::memory_order_relaxed);
+            stats[i].samples += 
+                thread->samples[i].load(std::memory_order_relaxed);
+            stats[i].ticks += thread->ticks[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    std::vector<function_stats> called;
+    for(const auto & stat : stats)
+        if(stat.calls > 0)
+            called.push_back(stat);
+    return called;
+}
+
+inline void dump(std::ostream & stream, format output)
+{
+    const auto stats = snapshot();
+    if(output == format::json)
+    {
+        stream << "[";
+        for(std::size_t i = 0; i < stats.size(); ++i)
+        {
+            stream << (i == 0 ? "" : ",") << "\n  {\"function\": \"" 
+                   << stats[i].name << "\", \"calls\": " << stats[i].calls 
+                   << ", \"samples\": " << stats[i].samples 
+                   << ", \"ticks\": " << stats[i].ticks << "}";
+        }
+        stream << "\n]\n";
+        return;
+    }
+
+    for(const auto & stat : stats)
+    {
+        stream << stat.name << ": " << stat.calls << " calls";
+        if(stat.samples > 0)
+            stream << ", " << stat.ticks / stat.samples 
+                   << " ticks per call (" << stat.samples << " samples)";
+        stream << "\n";
+    }
+}
+
+inline void reset()
+{
+    for(auto * thread = registry().load(std::memory_order_acquire); 
+        thread != nullptr; thread = thread->next)
+    {
+        for(std::size_t i = 0; i < function_count; ++i)
+        {
+            thread->calls[i].store(0, std::memory_order_relaxed);
+            thread->samples[i].store(0, std::memory_order_relaxed);
+            thread->ticks[i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+}}
+#endif
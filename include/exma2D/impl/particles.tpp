@@ -0,0 +1,221 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// ExMa2D - tiny EXternal MAth library for 2D
+// Copyright (c) 2016 Levi Taule
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PARTICLES_CPP
+#define PARTICLES_CPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include "../particles.hpp"
+#include "../execution.hpp"
+#include "../instrument.hpp"
+
+namespace exma { namespace particles {
+
+// Number of particles a thread takes at once, small enough for all their
+// arrays to stay in L1 cache between the integration and the wall passes
+constexpr std::size_t grain = 1024;
+
+// The loops below must not contain any branch, and neither a select whose 
+// arm is a constant: compilers split those back into branches, which keeps 
+// the loops from vectorizing unless trapping math is disabled. Conditions 
+// are therefore turned into factors of 0 or 1.
+
+// Limit of 0 stands for no limit, whose inverse is 0 as well
+template <typename N>
+N inverseLimit(N limit)
+{
+    return limit > 0 ? 1 / limit : 0;
+}
+
+// Same as std::min(value, 0), exactly
+template <typename N>
+N negativePart(N value)
+{
+    return (value - std::abs(value)) / 2;
+}
+
+template <typename T>
+T clampSpeed(const T & velocity, 
+             decltype(std::declval<T>().x) inverse_max_speed)
+{
+    using namespace exma::vector;
+    using component = decltype(std::declval<T>().x);
+
+    const auto ratio = std::sqrt(len2(velocity)) * inverse_max_speed;
+    const component over = ratio > 1;
+    return velocity * (1 / (1 + over * (ratio - 1)));
+}
+
+// Mirrors the particles which got behind the wall back in front of it,
+// velocity is reflected unless it already leads away from the wall
+template <typename T>
+void collide(T & position, T & velocity, const wall<T> & boundary)
+{
+    using namespace exma::vector;
+    using component = decltype(std::declval<T>().x);
+
+    const auto depth = negativePart(dot(position, boundary.normal) - 
+                                    boundary.offset);
+    position = position - boundary.normal * (2 * depth);
+
+    const component bounce = 
+        (depth < 0) & (dot(velocity, boundary.normal) < 0);
+    velocity = velocity + 
+        (reflectN(velocity, boundary.normal) - velocity) * bounce;
+}
+
+template <
+  typename Policy,
+  typename T,
+  typename = 
+    std::enable_if_t<exma::execution::is_execution_policy<Policy>{}>,
+  typename = 
+    std::enable_if_t<std::is_floating_point<decltype(std::declval<T>().x)>{}>,
+  typename = 
+    std::enable_if_t<std::is_floating_point<decltype(std::declval<T>().y)>{}>>
+void integrateEuler(const Policy & policy, 
+    const particle_arrays<decltype(std::declval<T>().x)> & particles, 
+    const integration_parameters<T> & parameters)
+{
+    EXMA_INSTRUMENT_TIME(instrument::function::integrateEuler);
+    using namespace exma::vector;
+    using component = decltype(std::declval<T>().x);
+
+    const auto dt = parameters.dt;
+    const T acceleration = parameters.gravity * dt;
+    const auto damping = std::max(1 - parameters.drag * dt, component{0});
+    const auto inverse_max_speed = inverseLimit(parameters.max_speed);
+    const auto walls = parameters.walls;
+    const auto wall_count = parameters.wall_count;
+
+    exma::execution::forEachRange(policy, particles.count, grain,
+        [&](std::size_t begin, std::size_t end)
+        {
+            auto * const x = particles.x;
+            auto * const y = particles.y;
+            auto * const vx = particles.vx;
+            auto * const vy = particles.vy;
+            for(auto i = begin; i < end; ++i)
+            {
+                const T velocity = clampSpeed(
+                    (T{vx[i], vy[i]} + acceleration) * damping, 
+                    inverse_max_speed);
+                const T position = T{x[i], y[i]} + velocity * dt;
+
+                x[i] = position.x;
+                y[i] = position.y;
+                vx[i] = velocity.x;
+                vy[i] = velocity.y;
+            }
+
+            // A separate pass per wall, the loops with a nested one
+            // don't vectorize
+            for(std::size_t w = 0; w < wall_count; ++w)
+            {
+                for(auto i = begin; i < end; ++i)
+                {
+                    T position{x[i], y[i]};
+                    T velocity{vx[i], vy[i]};
+                    collide(position, velocity, walls[w]);
+
+                    x[i] = position.x;
+                    y[i] = position.y;
+                    vx[i] = velocity.x;
+                    vy[i] = velocity.y;
+                }
+            }
+        });
+}
+
+template <
+  typename Policy,
+  typename T,
+  typename = 
+    std::enable_if_t<exma::execution::is_execution_policy<Policy>{}>,
+  typename = 
+    std::enable_if_t<std::is_floating_point<decltype(std::declval<T>().x)>{}>,
+  typename = 
+    std::enable_if_t<std::is_floating_point<decltype(std::declval<T>().y)>{}>>
+void integrateVerlet(const Policy & policy, 
+    const verlet_arrays<decltype(std::declval<T>().x)> & particles, 
+    const integration_parameters<T> & parameters)
+{
+    EXMA_INSTRUMENT_TIME(instrument::function::integrateVerlet);
+    using namespace exma::vector;
+    using component = decltype(std::declval<T>().x);
+
+    const auto dt = parameters.dt;
+    const T acceleration = parameters.gravity * (dt * dt);
+    const auto damping = std::max(1 - parameters.drag * dt, component{0});
+    // Displacement is the velocity times dt
+    const auto inverse_max_displacement = 
+        inverseLimit(parameters.max_speed * dt);
+    const auto walls = parameters.walls;
+    const auto wall_count = parameters.wall_count;
+
+    exma::execution::forEachRange(policy, particles.count, grain,
+        [&](std::size_t begin, std::size_t end)
+        {
+            auto * const x = particles.x;
+            auto * const y = particles.y;
+            auto * const previous_x = particles.previous_x;
+            auto * const previous_y = particles.previous_y;
+            for(auto i = begin; i < end; ++i)
+            {
+                const T position{x[i], y[i]};
+                const T displacement = clampSpeed(
+                    (position - T{previous_x[i], previous_y[i]}) * damping + 
+                    acceleration, inverse_max_displacement);
+
+                x[i] = position.x + displacement.x;
+                y[i] = position.y + displacement.y;
+                previous_x[i] = position.x;
+                previous_y[i] = position.y;
+            }
+
+            // A separate pass per wall, the loops with a nested one
+            // don't vectorize
+            for(std::size_t w = 0; w < wall_count; ++w)
+            {
+                for(auto i = begin; i < end; ++i)
+                {
+                    T next{x[i], y[i]};
+                    T displacement = next - T{previous_x[i], previous_y[i]};
+                    collide(next, displacement, walls[w]);
+
+                    x[i] = next.x;
+                    y[i] = next.y;
+                    previous_x[i] = next.x - displacement.x;
+                    previous_y[i] = next.y - displacement.y;
+                }
+            }
+        });
+}
+
+}}
+#endif
@@ -0,0 +1,179 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// ExMa2D - tiny EXternal MAth library for 2D
+// Copyright (c) 2016 Levi Taule
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef POINTS_CPP
+#define POINTS_CPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "../points.hpp"
+#include "../instrument.hpp"
+#include "../impl/utils.tpp"
+
+namespace exma { namespace points {
+
+// Cells are clamped, so that looking at their neighbours can't overflow
+constexpr std::intmax_t max_cell = 
+    std::numeric_limits<std::intmax_t>::max() / 2;
+
+template <
+  typename T,
+  typename N,
+  typename = 
+    std::enable_if_t<exma::utils::is_number<T>::value>>
+std::intmax_t toleranceCell(T value, 
+                           exma::utils::absolute_tolerance<N> tolerance)
+{
+    const double size = tolerance.value > 0 ? 
+        static_cast<double>(tolerance.value) : 1.;
+    const auto cell = std::floor(static_cast<double>(value) / size);
+    if(!(cell > -static_cast<double>(max_cell)))
+        return -max_cell;
+    if(!(cell < static_cast<double>(max_cell)))
+        return max_cell;
+    return static_cast<std::intmax_t>(cell);
+}
+
+template <
+  typename T,
+  typename = 
+    std::enable_if_t<exma::utils::is_number<T>::value>>
+std::intmax_t toleranceCell(T value, exma::utils::ulps_tolerance tolerance)
+{
+    const auto size = tolerance.value < static_cast<std::uintmax_t>(max_cell) ?
+        static_cast<std::intmax_t>(tolerance.value) + 1 : max_cell;
+    using exma::utils::ulpsOrdinal;
+    const auto ordinal = ulpsOrdinal(value);
+    auto cell = ordinal / size;
+    if(ordinal % size < 0)
+        --cell;
+    return std::max(-max_cell, std::min(cell, max_cell));
+}
+
+struct Cell
+{
+    std::intmax_t x, y;
+
+    bool operator==(const Cell & other) const
+    {
+        return x == other.x && y == other.y;
+    }
+};
+
+struct CellHash
+{
+    std::size_t operator()(const Cell & cell) const
+    {
+        const auto x = std::hash<std::intmax_t>{}(cell.x);
+        const auto y = std::hash<std::intmax_t>{}(cell.y);
+        return x ^ (y + 0x9e3779b9 + (x << 6) + (x >> 2));
+    }
+};
+
+template <
+  typename RandomIt,
+  typename Tolerance,
+  typename T = typename std::iterator_traits<RandomIt>::value_type,
+  typename = 
+    std::enable_if_t<exma::utils::is_number<decltype(std::declval<T>().x)>{}>,
+  typename = 
+    std::enable_if_t<exma::utils::is_number<decltype(std::declval<T>().y)>{}>>
+std::vector<std::size_t> weld(RandomIt first, RandomIt last, 
+                              const Tolerance tolerance)
+{
+    EXMA_INSTRUMENT_TIME(instrument::function::weld);
+    constexpr auto none = std::numeric_limits<std::size_t>::max();
+    const auto count = static_cast<std::size_t>(std::distance(first, last));
+
+    std::vector<std::size_t> remap(count);
+    // The kept points of a cell form a linked list, the map holds its head
+    std::vector<std::size_t> chain(count, none);
+    std::unordered_map<Cell, std::size_t, CellHash> cells;
+    cells.reserve(count);
+
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        const T & point = first[i];
+        const Cell cell{toleranceCell(point.x, tolerance), 
+                        toleranceCell(point.y, tolerance)};
+
+        remap[i] = i;
+        for(auto dx = -1; dx <= 1 && remap[i] == i; ++dx)
+        {
+            for(auto dy = -1; dy <= 1 && remap[i] == i; ++dy)
+            {
+                const auto found = cells.find({cell.x + dx, cell.y + dy});
+                if(found == cells.end())
+                    continue;
+                for(auto j = found->second; j != none; j = chain[j])
+                {
+                    const T & kept = first[j];
+                    if(exma::utils::compare(point.x, kept.x, tolerance) &&
+                       exma::utils::compare(point.y, kept.y, tolerance))
+                    {
+                        remap[i] = j;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if(remap[i] == i)
+        {
+            const auto inserted = cells.emplace(cell, i);
+            if(!inserted.second)
+            {
+                chain[i] = inserted.first->second;
+                inserted.first->second = i;
+            }
+        }
+    }
+    return remap;
+}
+
+template <
+  typename RandomIt,
+  typename T = typename std::iterator_traits<RandomIt>::value_type,
+  typename = 
+    std::enable_if_t<exma::utils::is_number<decltype(std::declval<T>().x)>{}>,
+  typename = 
+    std::enable_if_t<exma::utils::is_number<decltype(std::declval<T>().y)>{}>>
+std::vector<std::size_t> weld(RandomIt first, RandomIt last)
+{
+    using Component = decltype(std::declval<T>().x + std::declval<T>().y);
+    return weld(first, last, exma::utils::absolute(
+        std::numeric_limits<Component>::epsilon() * 10));
+}
+
+}}
+#endif
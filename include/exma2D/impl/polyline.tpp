@@ -0,0 +1,311 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// ExMa2D - tiny EXternal MAth library for 2D
+// Copyright (c) 2016 Levi Taule
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef POLYLINE_CPP
+#define POLYLINE_CPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../polyline.hpp"
+#include "../execution.hpp"
+#include "../instrument.hpp"
+#include "../impl/utils.tpp"
+
+namespace exma { namespace polyline {
+
+template <
+  typename T,
+  typename = 
+    std::enable_if_t<exma::utils::is_number<decltype(std::declval<T>().x)>{}>,
+  typename = 
+    std::enable_if_t<exma::utils::is_number<decltype(std::declval<T>().y)>{}>>
+constexpr auto segmentDistance2(const T & point, const T & a_vector, 
+                                const T & b_vector) ->
+decltype(point.x + point.y)
+{
+    EXMA_INSTRUMENT_COUNT(instrument::function::segmentDistance2);
+    using namespace exma::vector;
+
+    const T segment = b_vector - a_vector;
+    const T offset = point - a_vector;
+    const auto along = dot(offset, segment);
+    const auto length2 = len2(segment);
+    // Also covers the degenerated segment, which is never divided by
+    if(along <= 0)
+        return len2(offset);
+    if(along >= length2)
+        return len2(point - b_vector);
+    // The area of the parallelogram is the distance times the length, unlike
+    // project() it doesn't lose the fraction of integer components
+    const auto area = cross(offset, segment);
+    return area * area / length2;
+}
+
+// Integer products, which the distances scaled by the segment length are,
+// would overflow the component type already for short segments
+template <typename N>
+using scaled_t = 
+    std::conditional_t<std::is_integral<N>::value, std::intmax_t, N>;
+
+// Squared distance from the segment times the squared length of the 
+// segment, so that integer components don't need to be divided. Plain 
+// squared distance if the segment is degenerated.
+template <typename T>
+constexpr auto scaledSegmentDistance2(const T & point, const T & a_vector, 
+                                      const T & b_vector) ->
+scaled_t<decltype(point.x + point.y)>
+{
+    using namespace exma::vector;
+    using scaled = scaled_t<decltype(point.x + point.y)>;
+
+    const T segment = b_vector - a_vector;
+    const T offset = point - a_vector;
+    const auto along = dot(offset, segment);
+    const scaled length2 = len2(segment);
+    if(length2 == 0)
+        return len2(offset);
+    if(along <= 0)
+        return len2(offset) * length2;
+    if(along >= length2)
+        return len2(point - b_vector) * length2;
+    const scaled area = cross(offset, segment);
+    return area * area;
+}
+
+template <
+  typename RandomIt,
+  typename N,
+  typename T = typename std::iterator_traits<RandomIt>::value_type,
+  typename = 
+    std::enable_if_t<exma::utils::is_number<decltype(std::declval<T>().x)>{}>,
+  typename = 
+    std::enable_if_t<exma::utils::is_number<decltype(std::declval<T>().y)>{}>,
+  typename = typename std::enable_if_t<exma::utils::is_number<N>{}>>
+std::vector<std::size_t> simplifyRDP(RandomIt first, RandomIt last, 
+                                     const N epsilon)
+{
+    EXMA_INSTRUMENT_TIME(instrument::function::simplifyRDP);
+    using namespace exma::vector;
+
+    const auto count = static_cast<std::size_t>(std::distance(first, last));
+    std::vector<std::size_t> kept;
+    if(count < 3)
+    {
+        kept.resize(count);
+        std::iota(kept.begin(), kept.end(), std::size_t{0});
+        return kept;
+    }
+
+    const auto tolerance = epsilon * epsilon;
+    std::vector<bool> keep(count, false);
+    keep.front() = keep.back() = true;
+
+    // Spans between two kept points which still have to be examined
+    std::vector<std::pair<std::size_t, std::size_t>> stack;
+    stack.emplace_back(0, count - 1);
+    while(!stack.empty())
+    {
+        const auto span = stack.back();
+        stack.pop_back();
+
+        const T & a_vector = first[span.first];
+        const T & b_vector = first[span.second];
+        decltype(scaledSegmentDistance2(a_vector, a_vector, b_vector)) 
+            farthest = 0;
+        auto index = span.first;
+        for(auto i = span.first + 1; i < span.second; ++i)
+        {
+            const auto distance = 
+                scaledSegmentDistance2(first[i], a_vector, b_vector);
+            if(distance > farthest)
+            {
+                farthest = distance;
+                index = i;
+            }
+        }
+
+        // The tolerance is scaled the same way as the distances
+        const auto length2 = len2(b_vector - a_vector);
+        const auto scale = length2 > 0 ? 
+            static_cast<decltype(farthest)>(length2) : 1;
+        if(index != span.first && farthest > tolerance * scale)
+        {
+            keep[index] = true;
+            stack.emplace_back(span.first, index);
+            stack.emplace_back(index, span.second);
+        }
+    }
+
+    for(std::size_t i = 0; i < count; ++i)
+        if(keep[i])
+            kept.push_back(i);
+    return kept;
+}
+
+template <
+  typename RandomIt,
+  typename N,
+  typename T = typename std::iterator_traits<RandomIt>::value_type,
+  typename = 
+    std::enable_if_t<exma::utils::is_number<decltype(std::declval<T>().x)>{}>,
+  typename = 
+    std::enable_if_t<exma::utils::is_number<decltype(std::declval<T>().y)>{}>,
+  typename = typename std::enable_if_t<exma::utils::is_number<N>{}>>
+std::vector<std::size_t> simplifyVW(RandomIt first, RandomIt last, 
+                                    const N area)
+{
+    EXMA_INSTRUMENT_TIME(instrument::function::simplifyVW);
+    using namespace exma::vector;
+
+    const auto count = static_cast<std::size_t>(std::distance(first, last));
+    std::vector<std::size_t> kept;
+    if(count < 3)
+    {
+        kept.resize(count);
+        std::iota(kept.begin(), kept.end(), std::size_t{0});
+        return kept;
+    }
+
+    // Neighbours of the points still present in the polyline
+    std::vector<std::size_t> previous(count);
+    std::vector<std::size_t> next(count);
+    std::iota(previous.begin(), previous.end(), std::size_t{0} - 1);
+    std::iota(next.begin(), next.end(), std::size_t{1});
+
+    // Twice the area of the triangle, so we don't have to divide
+    auto triangle = [&](std::size_t i)
+    {
+        const T & a_vector = first[previous[i]];
+        const T & b_vector = first[i];
+        const T & c_vector = first[next[i]];
+        return exma::utils::abs(
+            cross(b_vector - a_vector, c_vector - a_vector));
+    };
+    using Area = decltype(triangle(0));
+
+    std::vector<Area> areas(count, std::numeric_limits<Area>::max());
+    std::vector<bool> removed(count, false);
+
+    // Outdated entries are not removed from the heap, they are skipped when
+    // they get on top instead
+    using Entry = std::pair<Area, std::size_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    for(std::size_t i = 1; i < count - 1; ++i)
+    {
+        areas[i] = triangle(i);
+        heap.emplace(areas[i], i);
+    }
+
+    const auto threshold = area * 2;
+    Area eliminated = 0;
+    while(!heap.empty())
+    {
+        const auto top = heap.top();
+        if(removed[top.second] || top.first != areas[top.second])
+        {
+            heap.pop();
+            continue;
+        }
+        if(!(top.first < threshold))
+            break;
+        heap.pop();
+
+        const auto i = top.second;
+        removed[i] = true;
+        next[previous[i]] = next[i];
+        previous[next[i]] = previous[i];
+
+        // A neighbour can't become less important than the point just
+        // eliminated, otherwise it would be dropped out of order
+        eliminated = top.first;
+        for(const auto neighbour : {previous[i], next[i]})
+        {
+            if(neighbour == 0 || neighbour == count - 1)
+                continue;
+            areas[neighbour] = std::max(triangle(neighbour), eliminated);
+            heap.emplace(areas[neighbour], neighbour);
+        }
+    }
+
+    for(std::size_t i = 0; i < count; ++i)
+        if(!removed[i])
+            kept.push_back(i);
+    return kept;
+}
+
+template <
+  typename Policy,
+  typename Polylines,
+  typename N,
+  typename = 
+    std::enable_if_t<exma::execution::is_execution_policy<Policy>{}>>
+std::vector<std::vector<std::size_t>> 
+simplifyRDP(const Policy & policy, const Polylines & polylines, 
+            const N epsilon)
+{
+    std::vector<std::vector<std::size_t>> result(polylines.size());
+    exma::execution::forEachRange(policy, result.size(), 1,
+        [&](std::size_t begin, std::size_t end)
+        {
+            for(auto i = begin; i < end; ++i)
+                result[i] = simplifyRDP(std::begin(polylines[i]), 
+                                        std::end(polylines[i]), epsilon);
+        });
+    return result;
+}
+
+template <
+  typename Policy,
+  typename Polylines,
+  typename N,
+  typename = 
+    std::enable_if_t<exma::execution::is_execution_policy<Policy>{}>>
+std::vector<std::vector<std::size_t>> 
+simplifyVW(const Policy & policy, const Polylines & polylines, 
+           const N area)
+{
+    std::vector<std::vector<std::size_t>> result(polylines.size());
+    exma::execution::forEachRange(policy, result.size(), 1,
+        [&](std::size_t begin, std::size_t end)
+        {
+            for(auto i = begin; i < end; ++i)
+                result[i] = simplifyVW(std::begin(polylines[i]), 
+                                       std::end(polylines[i]), area);
+        });
+    return result;
+}
+
+}}
+#endif
@@ -26,15 +26,38 @@
 #ifndef UTILS_CPP
 #define UTILS_CPP
 
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <type_traits>
 #include <limits>
 
 namespace exma { namespace utils {
 
+// Answers if the type can be a vector component, specialize it for your own
+// number types
+template <typename T>
+struct is_number : std::is_arithmetic<T> {};
+
+// Sine and cosine of the components' type, the arithmetic types use double
+template <typename T>
+struct trigonometry
+{
+    static double cos(double angle)
+    {
+        return std::cos(angle);
+    }
+
+    static double sin(double angle)
+    {
+        return std::sin(angle);
+    }
+};
+
 template <
   typename T,
   typename = 
-    std::enable_if_t<std::is_arithmetic<T>::value>>
+    std::enable_if_t<is_number<T>::value>>
 constexpr T abs (T number)
 {
     if(number < 0)
@@ -46,7 +69,7 @@ constexpr T abs (T number)
 template <
   typename T,
   typename = 
-    std::enable_if_t<std::is_arithmetic<T>::value>>
+    std::enable_if_t<is_number<T>::value>>
 constexpr bool compare (T a, T b)
 {
     // Due to the usage trigonometric functions, it seems, we must be 10 times 
@@ -57,6 +80,97 @@ constexpr bool compare (T a, T b)
     return false;
 };
 
+// Tolerance of the given absolute difference
+template <typename T>
+struct absolute_tolerance
+{
+    T value;
+};
+
+// Tolerance of the given number of representable values in between, that is
+// relative to the magnitude of the compared numbers
+struct ulps_tolerance
+{
+    std::uintmax_t value;
+};
+
+template <
+  typename T,
+  typename = 
+    std::enable_if_t<is_number<T>::value>>
+constexpr absolute_tolerance<T> absolute(T value)
+{
+    return {abs(value)};
+};
+
+constexpr ulps_tolerance ulps(std::uintmax_t value)
+{
+    return {value};
+};
+
+template <
+  typename T,
+  typename N,
+  typename = 
+    std::enable_if_t<is_number<T>::value>>
+constexpr bool compare (T a, T b, absolute_tolerance<N> tolerance)
+{
+    return abs(a-b) <= tolerance.value;
+};
+
+// Maps the number onto an integer, so that the neighbouring representable
+// numbers differ by 1
+template <
+  typename T,
+  typename = 
+    std::enable_if_t<std::is_integral<T>::value>>
+constexpr std::intmax_t ulpsOrdinal (T number)
+{
+    return static_cast<std::intmax_t>(number);
+};
+
+template <
+  typename T,
+  typename = 
+    std::enable_if_t<std::is_floating_point<T>::value>,
+  typename = 
+    std::enable_if_t<std::numeric_limits<T>::is_iec559 &&
+                     (sizeof(T) == 4 || sizeof(T) == 8)>>
+std::intmax_t ulpsOrdinal (T number)
+{
+    using Bits = std::conditional_t<sizeof(T) == 4, 
+                                    std::uint32_t, std::uint64_t>;
+    using Ordinal = std::conditional_t<sizeof(T) == 4, 
+                                       std::int32_t, std::int64_t>;
+    constexpr Bits sign = Bits{1} << (sizeof(T) * 8 - 1);
+
+    Bits bits;
+    std::memcpy(&bits, &number, sizeof(T));
+    // Negative numbers are stored as sign and magnitude, turn them into
+    // two's complement so that the order of the numbers is kept
+    const Bits magnitude = bits & ~sign;
+    const auto ordinal = static_cast<Ordinal>(magnitude);
+    return (bits & sign) ? -static_cast<std::intmax_t>(ordinal) : ordinal;
+};
+
+template <
+  typename T,
+  typename = 
+    std::enable_if_t<is_number<T>::value>>
+bool compare (T a, T b, ulps_tolerance tolerance)
+{
+    if(std::isnan(static_cast<double>(a)) || std::isnan(static_cast<double>(b)))
+        return false;
+    const auto a_ordinal = ulpsOrdinal(a);
+    const auto b_ordinal = ulpsOrdinal(b);
+    const auto difference = a_ordinal < b_ordinal ?
+        static_cast<std::uintmax_t>(b_ordinal) - 
+            static_cast<std::uintmax_t>(a_ordinal) :
+        static_cast<std::uintmax_t>(a_ordinal) - 
+            static_cast<std::uintmax_t>(b_ordinal);
+    return difference <= tolerance.value;
+};
+
 }}
 
 #endif
\ No newline at end of file
@@ -29,72 +29,68 @@
 #include <limits>
 #include <type_traits>
 #include "../vector2D.hpp"
+#include "../instrument.hpp"
 #include "../impl/utils.tpp"
 
+// Template heads of the functions taking a vector, or a vector and a scalar
+#if EXMA_CONCEPTS
+#define EXMA_VECTOR_TEMPLATE(T) template <Vector2DLike T>
+#define EXMA_VECTOR_SCALAR_TEMPLATE(T, N) \
+    template <Vector2DLike T, typename N> \
+    requires exma::utils::is_number<N>::value
+#else
+#define EXMA_VECTOR_TEMPLATE(T) \
+    template < \
+      typename T, \
+      typename = std::enable_if_t< \
+        exma::utils::is_number<decltype(std::declval<T>().x)>{}>, \
+      typename = std::enable_if_t< \
+        exma::utils::is_number<decltype(std::declval<T>().y)>{}>>
+#define EXMA_VECTOR_SCALAR_TEMPLATE(T, N) \
+    template < \
+      typename T, \
+      typename N, \
+      typename = std::enable_if_t< \
+        exma::utils::is_number<decltype(std::declval<T>().x)>{}>, \
+      typename = std::enable_if_t< \
+        exma::utils::is_number<decltype(std::declval<T>().y)>{}>, \
+      typename = std::enable_if_t<exma::utils::is_number<N>{}>>
+#endif
+
 namespace exma { namespace vector {
 
-template <
-  typename T,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().x)>{}>,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().y)>{}>>
+EXMA_VECTOR_TEMPLATE(T)
 constexpr T operator+(const T & a_vector, const T & b_vector)
 {
+    EXMA_INSTRUMENT_COUNT(instrument::function::add);
     return{a_vector.x + b_vector.x, a_vector.y + b_vector.y};
 }
 
-template <
-  typename T,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().x)>{}>,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().y)>{}>>
+EXMA_VECTOR_TEMPLATE(T)
 constexpr T operator-(const T & a_vector, const T & b_vector)
 {
+    EXMA_INSTRUMENT_COUNT(instrument::function::subtract);
     return{a_vector.x - b_vector.x, a_vector.y - b_vector.y};
 }
 
-template <
-  typename N,
-  typename T,
-  typename = 
-std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().x)>{}>,
-  typename = 
-std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().y)>{}>,
-  typename = typename std::enable_if_t<std::is_arithmetic<N>{}>>
+EXMA_VECTOR_SCALAR_TEMPLATE(T, N)
 constexpr T operator*(const T & vector, const N factor)
 {
+    EXMA_INSTRUMENT_COUNT(instrument::function::multiply);
     return {vector.x * factor, vector.y * factor};
 }
 
-template <
-  typename T,
-  typename N,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().x)>{}>,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().y)>{}>,
-  typename = typename std::enable_if_t<std::is_arithmetic<N>{}>>
+EXMA_VECTOR_SCALAR_TEMPLATE(T, N)
 constexpr T operator*(const N factor, const T & vector)
 {
-    return vector * factor;
+    EXMA_INSTRUMENT_COUNT(instrument::function::multiply);
+    return {factor * vector.x, factor * vector.y};
 }
 
-template <
-  typename N,
-  typename T,
-  typename = 
-std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().x)>{}>,
-  typename = 
-std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().y)>{}>,
-  typename = typename std::enable_if_t<std::is_arithmetic<N>{}>,
-  typename = std::enable_if<
-    std::numeric_limits<decltype(std::declval<T>().x)>::has_quiet_NaN>,
-  typename = std::enable_if<
-    std::numeric_limits<decltype(std::declval<T>().y)>::has_quiet_NaN>>
+EXMA_VECTOR_SCALAR_TEMPLATE(T, N)
 constexpr T operator/(const T & vector, const N factor)
 {
+    EXMA_INSTRUMENT_COUNT(instrument::function::divide);
     if(exma::utils::compare(factor, static_cast<N>(0)))
     {
         return
@@ -106,170 +102,116 @@ constexpr T operator/(const T & vector, const N factor)
     return {vector.x / factor, vector.y / factor};
 }
 
-template <
-  typename T,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().x)>{}>,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().y)>{}>>
+EXMA_VECTOR_TEMPLATE(T)
 constexpr bool operator==(const T & a_vector, const T & b_vector)
 {
+    EXMA_INSTRUMENT_COUNT(instrument::function::equal);
     return
         exma::utils::compare(a_vector.x, b_vector.x) &&
         exma::utils::compare(a_vector.y, b_vector.y);
 }
 
-template <
-  typename T,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().x)>{}>,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().y)>{}>>
+EXMA_VECTOR_TEMPLATE(T)
 constexpr bool operator!=(const T & a_vector, const T & b_vector)
 {
-    return !(a_vector == b_vector);
+    EXMA_INSTRUMENT_COUNT(instrument::function::not_equal);
+    return
+        !exma::utils::compare(a_vector.x, b_vector.x) ||
+        !exma::utils::compare(a_vector.y, b_vector.y);
 }
 
-template <
-  typename T,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().x)>{}>,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().y)>{}>>
+EXMA_VECTOR_TEMPLATE(T)
 constexpr T operator-(const T & vector)
 {
+    EXMA_INSTRUMENT_COUNT(instrument::function::negate);
     return {-vector.x, -vector.y};
 }
 
-template <
-  typename T,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().x)>{}>,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().y)>{}>>
+EXMA_VECTOR_TEMPLATE(T)
 constexpr T perpendicule(const T & vector)
 {
+    EXMA_INSTRUMENT_COUNT(instrument::function::perpendicule);
     return {-vector.y, vector.x};
 }
 
-template <
-  typename T,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().x)>{}>,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().y)>{}>>
+EXMA_VECTOR_TEMPLATE(T)
 constexpr auto dot(const T & a_vector, const T & b_vector) ->
 decltype(a_vector.x + b_vector.x)
 {
+    EXMA_INSTRUMENT_COUNT(instrument::function::dot);
     return (a_vector.x * b_vector.x) + (a_vector.y * b_vector.y);
 }
 
-template <
-  typename T,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().x)>{}>,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().y)>{}>>
+EXMA_VECTOR_TEMPLATE(T)
 constexpr auto cross(const T & a_vector, const T & b_vector) ->
 decltype(a_vector.x + b_vector.x)
 {
+    EXMA_INSTRUMENT_COUNT(instrument::function::cross);
     return (a_vector.x * b_vector.y) - (a_vector.y * b_vector.x);
 }
 
-template <
-  typename T,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().x)>{}>,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().y)>{}>>
+EXMA_VECTOR_TEMPLATE(T)
 constexpr auto len2(const T & vector) ->
 decltype(vector.x + vector.y)
 {
+    EXMA_INSTRUMENT_COUNT(instrument::function::len2);
     return dot(vector, vector);
 }
 
-template <
-  typename T,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().x)>{}>,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().y)>{}>>
+EXMA_VECTOR_TEMPLATE(T)
 auto len(const T & vector) ->
 decltype(vector.x + vector.y)
 {
+    EXMA_INSTRUMENT_TIME(instrument::function::len);
     return sqrt(len2(vector));
 }
 
-template <
-  typename T,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().x)>{}>,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().y)>{}>>
+EXMA_VECTOR_TEMPLATE(T)
 auto distance(const T & a_vector, const T & b_vector) ->
 decltype(a_vector.x + a_vector.y + b_vector.x + b_vector.y)
 {
+    EXMA_INSTRUMENT_TIME(instrument::function::distance);
     return len(a_vector - b_vector);
 }
 
-template <
-  typename T,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().x)>{}>,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().y)>{}>>
+EXMA_VECTOR_TEMPLATE(T)
 T normalize(const T & vector)
 {
+    EXMA_INSTRUMENT_TIME(instrument::function::normalize);
     return vector/len(vector);
 }
 
-template <
-  typename T,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().x)>{}>,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().y)>{}>,
-  typename = std::enable_if<
-    std::numeric_limits<decltype(std::declval<T>().x)>::has_quiet_NaN>,
-  typename = std::enable_if<
-    std::numeric_limits<decltype(std::declval<T>().y)>::has_quiet_NaN>>
+EXMA_VECTOR_TEMPLATE(T)
 constexpr T project(const T & vector, const T & axis)
 {
-    if(exma::utils::compare(axis.x, 0.f) && exma::utils::compare(axis.y, 0.f))
+    EXMA_INSTRUMENT_COUNT(instrument::function::project);
+    // A short fixed-point axis can square to zero without being zero itself
+    const auto length2 = len2(axis);
+    if((exma::utils::compare(axis.x, decltype(axis.x){0}) && 
+        exma::utils::compare(axis.y, decltype(axis.y){0})) || length2 == 0)
         return
         {
             std::numeric_limits<decltype(std::declval<T>().x)>::quiet_NaN(),
             std::numeric_limits<decltype(std::declval<T>().y)>::quiet_NaN()
         };
-    auto quantifier = dot(vector, axis) / len2(axis);
+    auto quantifier = dot(vector, axis) / length2;
     return {axis.x * quantifier, axis.y * quantifier};
 }
 
-template <
-  typename T,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().x)>{}>,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().y)>{}>>
+EXMA_VECTOR_TEMPLATE(T)
 constexpr T projectN(const T vector, const T axis)
 {
+    EXMA_INSTRUMENT_COUNT(instrument::function::projectN);
     auto quantifier = dot(vector, axis);
     return {axis.x * quantifier, axis.y * quantifier};
 }
 
-template <
-  typename T,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().x)>{}>,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().y)>{}>,
-  typename = std::enable_if<
-    std::numeric_limits<decltype(std::declval<T>().x)>::has_quiet_NaN>,
-  typename = std::enable_if<
-    std::numeric_limits<decltype(std::declval<T>().y)>::has_quiet_NaN>>
+EXMA_VECTOR_TEMPLATE(T)
 constexpr T reflect(const T & vector, const T & axis)
 {
-    if(exma::utils::compare(axis.x, 0.f) && exma::utils::compare(axis.y, 0.f))
+    EXMA_INSTRUMENT_COUNT(instrument::function::reflect);
+    if((exma::utils::compare(axis.x, decltype(axis.x){0}) && 
+        exma::utils::compare(axis.y, decltype(axis.y){0})) || len2(axis) == 0)
         return
         {
             std::numeric_limits<decltype(std::declval<T>().x)>::quiet_NaN(),
@@ -279,28 +221,22 @@ constexpr T reflect(const T & vector, const T & axis)
     return {vector.x - result.x, vector.y - result.y};
 }
 
-template <
-  typename T,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().x)>{}>,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().y)>{}>>
+EXMA_VECTOR_TEMPLATE(T)
 constexpr T reflectN(const T & vector, const T & axis)
 {
+    EXMA_INSTRUMENT_COUNT(instrument::function::reflectN);
     auto result = projectN(vector, axis) * 2;
     return {vector.x - result.x, vector.y - result.y};
 }
 
-template <
-  typename T,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().x)>{}>,
-  typename = 
-    std::enable_if_t<std::is_arithmetic<decltype(std::declval<T>().y)>{}>>
+EXMA_VECTOR_TEMPLATE(T)
 T rotate(const T & vector, const T & origin, Radians angle)
 {
-    const auto cr = cos(angle.getValue());
-    const auto sr = sin(angle.getValue());
+    EXMA_INSTRUMENT_TIME(instrument::function::rotate);
+    using trigonometry = 
+        exma::utils::trigonometry<decltype(std::declval<T>().x)>;
+    const auto cr = trigonometry::cos(angle.getValue());
+    const auto sr = trigonometry::sin(angle.getValue());
     const auto x = origin.x + (
         (vector.x - origin.x) * cr - (vector.y - origin.y) * sr
     );
@@ -314,4 +250,8 @@ T rotate(const T & vector, const T & origin, Radians angle)
 }
 
 }}
+
+#undef EXMA_VECTOR_TEMPLATE
+#undef EXMA_VECTOR_SCALAR_TEMPLATE
+
 #endif
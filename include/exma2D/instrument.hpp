@@ -0,0 +1,179 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// ExMa2D - tiny EXternal MAth library for 2D
+// Copyright (c) 2016 Levi Taule
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INSTRUMENT_HPP
+#define INSTRUMENT_HPP
+
+/// @file
+/// @brief Opt-in instrumentation of the library functions
+/// @details
+/// Define `EXMA_INSTRUMENT` before including any of the library headers 
+/// (preferably on the command line, so that all the translation units agree) 
+/// to count the calls of every library function and to measure the duration 
+/// of some of them. Without it, the hooks expand to nothing and none of the 
+/// declarations below exist.\n
+/// Only every `EXMA_INSTRUMENT_SAMPLING`-th call (64 by default, must be 
+/// a power of 2) of a function is timed, in ticks of the time stamp counter 
+/// where available. The functions which are `constexpr` are only counted, as 
+/// they are too cheap to be timed and C++14 doesn't let them hold the timer.
+/// Calls made during constant evaluation are not counted, which requires 
+/// `__builtin_is_constant_evaluated()` (g++ 9, clang 9) or C++20's 
+/// `std::is_constant_evaluated()`, otherwise the functions can't be used in 
+/// constant expressions while instrumented.\n
+/// The counters are thread-local, so the instrumented functions never lock 
+/// or contend. For instance:
+/// @code
+/// // g++ -DEXMA_INSTRUMENT ...
+/// exma::instrument::dump(std::cout, exma::instrument::format::json);
+/// @endcode
+
+#ifdef EXMA_INSTRUMENT
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+#ifndef EXMA_INSTRUMENT_SAMPLING
+#define EXMA_INSTRUMENT_SAMPLING 64
+#endif
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define EXMA_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#endif
+// g++ 9 has the builtin, but not __has_builtin
+#if !defined(EXMA_IS_CONSTANT_EVALUATED) && defined(__GNUC__) && \
+    !defined(__clang__) && __GNUC__ >= 9
+#define EXMA_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#if !defined(EXMA_IS_CONSTANT_EVALUATED) && \
+    defined(__cpp_lib_is_constant_evaluated)
+#define EXMA_IS_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#endif
+#ifndef EXMA_IS_CONSTANT_EVALUATED
+#define EXMA_IS_CONSTANT_EVALUATED() false
+#endif
+
+/// @brief Counts the call of **id**, usable in `constexpr` functions
+#define EXMA_INSTRUMENT_COUNT(id) \
+    (EXMA_IS_CONSTANT_EVALUATED() ? void() : ::exma::instrument::count(id))
+
+/// @brief Counts the call of **id** and times the rest of the scope
+#define EXMA_INSTRUMENT_TIME(id) \
+    const ::exma::instrument::timer exma_instrument_timer_{id}
+
+namespace exma {
+
+/// @brief Call counts and timings of the library functions
+namespace instrument {
+
+static_assert((EXMA_INSTRUMENT_SAMPLING & (EXMA_INSTRUMENT_SAMPLING - 1)) == 0,
+              "EXMA_INSTRUMENT_SAMPLING must be a power of 2");
+
+/// @brief The instrumented functions
+enum class function : std::size_t
+{
+    add, subtract, multiply, divide, equal, not_equal, negate, perpendicule, 
+    dot, cross, len2, len, distance, normalize, project, projectN, reflect, 
+    reflectN, rotate, segmentDistance2, simplifyRDP, simplifyVW, weld, 
+    integrateEuler, integrateVerlet, fixed_translate, fixed_scale, 
+    fixed_rotate,
+    count
+};
+
+/// @brief Output format of dump()
+enum class format
+{
+    text, json
+};
+
+/// @brief Statistics of one function, summed over all the threads
+struct function_stats
+{
+    const char * name;
+    std::uint64_t calls;
+    /// Number of the timed calls
+    std::uint64_t samples;
+    /// Total duration of the timed calls
+    std::uint64_t ticks;
+};
+
+/// @brief Reads the time stamp counter, or the steady clock if there is none
+inline std::uint64_t ticks();
+
+/// @brief Counts a call of **id** in the calling thread
+inline void count(function id);
+
+/// @brief Counts a call of **id** and times it, if it is sampled
+class timer
+{
+public:
+    explicit timer(function id);
+    ~timer();
+
+    timer(const timer &) = delete;
+    timer & operator=(const timer &) = delete;
+
+private:
+    function m_id;
+    bool m_sampled;
+    std::uint64_t m_start;
+};
+
+/// @brief Collects the statistics of all the threads
+/// @details
+/// Threads which have already finished are included as well.
+///
+/// @return
+/// Statistics of the functions called at least once
+inline std::vector<function_stats> snapshot();
+
+/// @brief Writes snapshot() into **stream**
+///
+/// @param stream
+/// @param output
+inline void dump(std::ostream & stream, format output = format::text);
+
+/// @brief Zeroes the statistics of all the threads
+/// @details
+/// Calls running concurrently with reset() may survive it.
+inline void reset();
+
+}
+}
+
+#include "impl/instrument.tpp"
+
+#else
+
+#define EXMA_INSTRUMENT_COUNT(id) void()
+#define EXMA_INSTRUMENT_TIME(id)
+
+#endif
+
+#endif
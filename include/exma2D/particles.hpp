@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// ExMa2D - tiny EXternal MAth library for 2D
+// Copyright (c) 2016 Levi Taule
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PARTICLES_HPP
+#define PARTICLES_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include "vector2D.hpp"
+#include "execution.hpp"
+
+/// @file
+
+namespace exma {
+
+/// @brief Batched integration of particle systems
+/// @details The particles are stored as structure of arrays, one array per 
+/// component, so that the whole system can be advanced in a single 
+/// vectorizable pass. The parameters are expressed in your vector class 
+/// (see exma::vector for the requirements), whose components must be 
+/// floating-point numbers. For instance:
+/// @code
+/// particle_arrays<float> particles{x, y, vx, vy, count};
+/// integration_parameters<VectorF> parameters;
+/// parameters.dt = 1.f / 60;
+/// parameters.gravity = {0.f, -9.81f};
+/// integrateEuler(exma::execution::par, particles, parameters);
+/// @endcode
+/// The loops are branch-free and vectorize at `-O3`, as long as 
+/// `-fno-math-errno` lets the compiler vectorize the `std::sqrt()` of the 
+/// speed clamping.
+
+namespace particles {
+
+/// @brief Positions and velocities of the particles, used by integrateEuler()
+template <typename N>
+struct particle_arrays
+{
+    N * x;
+    N * y;
+    N * vx;
+    N * vy;
+    std::size_t count;
+};
+
+/// @brief Current and previous positions of the particles, used by 
+/// integrateVerlet()
+template <typename N>
+struct verlet_arrays
+{
+    N * x;
+    N * y;
+    N * previous_x;
+    N * previous_y;
+    std::size_t count;
+};
+
+/// @brief A half-plane the particles are kept in
+/// @details
+/// The particles are kept where `dot(position, normal) >= offset`. Particles 
+/// which get out are mirrored back and their velocity is reflected by 
+/// reflectN().
+template <typename T>
+struct wall
+{
+    /// Must be a unit vector
+    T normal;
+    decltype(std::declval<T>().x) offset;
+};
+
+/// @brief Parameters of one integration step
+template <typename T>
+struct integration_parameters
+{
+    using component = decltype(std::declval<T>().x);
+
+    /// Length of the step
+    component dt = 0;
+    /// Acceleration applied to every particle
+    T gravity{0, 0};
+    /// Fraction of the velocity lost per unit of time
+    component drag = 0;
+    /// Maximal speed of a particle, `0` means unlimited
+    component max_speed = 0;
+    /// Walls the particles bounce off, may be `nullptr` if **wall_count** 
+    /// is `0`
+    const wall<T> * walls = nullptr;
+    std::size_t wall_count = 0;
+};
+
+/// @brief Advances the particles by semi-implicit (symplectic) Euler method
+/// @details
+/// The velocity is updated first and the position is moved by the new 
+/// velocity.
+///
+/// @param policy
+/// exma::execution::seq or exma::execution::par
+/// @param particles
+/// @param parameters
+template <typename Policy, typename T, typename, typename, typename>
+void integrateEuler(const Policy & policy, 
+    const particle_arrays<decltype(std::declval<T>().x)> & particles, 
+    const integration_parameters<T> & parameters);
+
+/// @brief Advances the particles by position Verlet method
+/// @details
+/// The velocity is implied by the difference of the current and the previous 
+/// positions, so it needn't be stored. The first step continues with the 
+/// velocity `(position - previous) / dt`.
+///
+/// @param policy
+/// exma::execution::seq or exma::execution::par
+/// @param particles
+/// @param parameters
+template <typename Policy, typename T, typename, typename, typename>
+void integrateVerlet(const Policy & policy, 
+    const verlet_arrays<decltype(std::declval<T>().x)> & particles, 
+    const integration_parameters<T> & parameters);
+
+}
+}
+
+#include "impl/particles.tpp"
+
+#endif
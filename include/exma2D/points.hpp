@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// ExMa2D - tiny EXternal MAth library for 2D
+// Copyright (c) 2016 Levi Taule
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef POINTS_HPP
+#define POINTS_HPP
+
+#include <cstddef>
+#include <vector>
+#include "vector2D.hpp"
+#include "impl/utils.tpp"
+
+/// @file
+
+namespace exma {
+
+/// @brief Operations on whole point sets
+/// @details These functions work on random-access ranges of vectors (see 
+/// exma::vector for the requirements on the vector class).
+
+namespace points {
+
+/// @brief Finds the points which are the same within **tolerance**
+/// @details
+/// The points are compared component-wise, the same way as operator==() does, 
+/// only with a user-set tolerance. **tolerance** is either 
+/// `exma::utils::absolute(value)` or `exma::utils::ulps(count)`.\n
+/// Every point is matched only against the points which are kept 
+/// (not welded to anything), and only against those in the neighbouring cells 
+/// of a **tolerance** sized grid, so the expected complexity is `O(n)`.
+/// For instance:
+/// @code
+/// auto remap = weld(mesh.begin(), mesh.end(), exma::utils::absolute(1e-4f));
+/// for(auto & index : triangles)
+///     index = remap[index];
+/// @endcode
+///
+/// @param first
+/// @param last
+/// The points as a range of random-access iterators
+/// @param tolerance
+///
+/// @return
+/// The remap table, the i-th item is the index of the point the i-th point 
+/// was welded to. It never points to a later point and it points to itself 
+/// for the kept points.
+template <typename RandomIt, typename Tolerance, typename, typename, typename>
+std::vector<std::size_t> weld(RandomIt first, RandomIt last, 
+                              const Tolerance tolerance);
+
+/// @brief Finds the points which are the same
+/// @details
+/// Same as the weld() above with the tolerance of operator==(), that is 
+/// `std::numeric_limits<T>::epsilon() * 10`.
+///
+/// @param first
+/// @param last
+/// The points as a range of random-access iterators
+///
+/// @return
+/// The remap table
+template <typename RandomIt, typename, typename, typename>
+std::vector<std::size_t> weld(RandomIt first, RandomIt last);
+
+}
+}
+
+#include "impl/points.tpp"
+
+#endif
@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// ExMa2D - tiny EXternal MAth library for 2D
+// Copyright (c) 2016 Levi Taule
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef POLYLINE_HPP
+#define POLYLINE_HPP
+
+#include <cstddef>
+#include <vector>
+#include "vector2D.hpp"
+#include "execution.hpp"
+
+/// @file
+
+namespace exma {
+
+/// @brief Polyline simplification
+/// @details These functions work on random-access ranges of vectors (see 
+/// exma::vector for the requirements on the vector class). Instead of copying 
+/// the points they return ascending indices of the points to keep, the first 
+/// and the last point are always kept. For instance:
+/// @code
+/// std::vector<VectorF> track = load();
+/// auto kept = simplifyRDP(track.begin(), track.end(), 0.5f);
+/// @endcode
+
+namespace polyline {
+
+/// @brief Finds out the squared distance between **point** and the segment 
+/// from **a_vector** to **b_vector**
+/// @details
+/// If the segment is degenerated (**a_vector** == **b_vector**), the squared 
+/// distance to **a_vector** is returned. With integer components the result 
+/// is rounded down.
+///
+/// @param point
+/// @param a_vector
+/// @param b_vector
+///
+/// @return
+/// The squared distance of **point** from the segment
+template <typename T, typename, typename>
+constexpr auto segmentDistance2(const T & point, const T & a_vector, 
+                                const T & b_vector) ->
+decltype(point.x + point.y);
+
+/// @brief Simplifies the polyline by Ramer-Douglas-Peucker algorithm
+/// @details
+/// The algorithm is iterative, so arbitrarily long polylines can't overflow 
+/// the call stack. Every dropped point lies within **epsilon** of the 
+/// segment that replaces it, the distances are compared without division, 
+/// so this holds for integer components as well.\n
+/// The complexity is `O(n log n)` on average and `O(n^2)` in the worst case.
+///
+/// @param first
+/// @param last
+/// The polyline as a range of random-access iterators
+/// @param epsilon
+/// *Must be of an arithmetic (an integer or a floating-point number) type.*
+/// The maximal allowed distance of a dropped point from the simplified line
+///
+/// @return
+/// Ascending indices of the kept points
+template <typename RandomIt, typename N, typename, typename, typename, 
+          typename>
+std::vector<std::size_t> simplifyRDP(RandomIt first, RandomIt last, 
+                                     const N epsilon);
+
+/// @brief Simplifies the polyline by Visvalingam-Whyatt algorithm
+/// @details
+/// Repeatedly drops the point which forms the triangle of the smallest area 
+/// with its neighbours, until all the remaining triangles are at least 
+/// **area** large. Tends to produce smoother shapes than simplifyRDP().\n
+/// The complexity is `O(n log n)`.
+///
+/// @param first
+/// @param last
+/// The polyline as a range of random-access iterators
+/// @param area
+/// *Must be of an arithmetic (an integer or a floating-point number) type.*
+/// The minimal effective area of a kept point
+///
+/// @return
+/// Ascending indices of the kept points
+template <typename RandomIt, typename N, typename, typename, typename, 
+          typename>
+std::vector<std::size_t> simplifyVW(RandomIt first, RandomIt last, 
+                                    const N area);
+
+/// @brief Simplifies every polyline in **polylines** by simplifyRDP()
+/// @details
+/// With exma::execution::par the polylines are distributed among threads.
+///
+/// @param policy
+/// exma::execution::seq or exma::execution::par
+/// @param polylines
+/// A random-access container of polylines, each polyline being a container 
+/// of vectors
+/// @param epsilon
+///
+/// @return
+/// Indices of the kept points, one list per polyline
+template <typename Policy, typename Polylines, typename N, typename>
+std::vector<std::vector<std::size_t>> 
+simplifyRDP(const Policy & policy, const Polylines & polylines, 
+            const N epsilon);
+
+/// @brief Simplifies every polyline in **polylines** by simplifyVW()
+/// @details
+/// With exma::execution::par the polylines are distributed among threads.
+///
+/// @param policy
+/// exma::execution::seq or exma::execution::par
+/// @param polylines
+/// A random-access container of polylines, each polyline being a container 
+/// of vectors
+/// @param area
+///
+/// @return
+/// Indices of the kept points, one list per polyline
+template <typename Policy, typename Polylines, typename N, typename>
+std::vector<std::vector<std::size_t>> 
+simplifyVW(const Policy & policy, const Polylines & polylines, 
+           const N area);
+
+}
+}
+
+#include "impl/polyline.tpp"
+
+#endif
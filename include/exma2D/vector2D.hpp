@@ -27,15 +27,33 @@
 #define VECTOR_HPP
 
 #include <type_traits>
+#include <utility>
 #include "vendor/degrad/degrad.h"
+#include "impl/utils.tpp"
 
 /// @file
 
+/// @brief Whether the functions are constrained by concepts rather than 
+/// `std::enable_if`
+/// @details
+/// Concepts are used when the compiler supports them (C++20). They are 
+/// cheaper to compile and give much shorter error messages. Define it to `0` 
+/// to force the C++14 implementation.
+#ifndef EXMA_CONCEPTS
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+#define EXMA_CONCEPTS 1
+#else
+#define EXMA_CONCEPTS 0
+#endif
+#endif
+
 namespace exma {
 
 /// @brief Definitions of common 2D vector operations
 /// @details These functions work on any vector class which has public
 /// **x** and **y** members, and can be initialized via argument list.
+/// The members can be of an arithmetic type, or of a fixed-point type from 
+/// exma::fixed.
 /// For instance:
 /// @code
 /// struct VectorF
@@ -46,6 +64,17 @@ namespace exma {
 
 namespace vector {
 
+#if EXMA_CONCEPTS
+/// @brief Requirements on the vector class
+/// @details
+/// The vector class must have public **x** and **y** members of an arithmetic
+/// or fixed-point (see exma::fixed) type.
+template <typename T>
+concept Vector2DLike =
+    exma::utils::is_number<decltype(std::declval<T>().x)>::value &&
+    exma::utils::is_number<decltype(std::declval<T>().y)>::value;
+#endif
+
 /// @brief Creates a vector from addition of two vectors
 ///
 /// @param a_vector
@@ -112,7 +141,8 @@ constexpr T operator/(const T & vector, const N factor);
 /// @brief Answers if the vectors have the same components
 /// @details
 /// The tolerance for the component comparison is 
-/// `std::numeric_limits<T>::epsilon() * 10`
+/// `std::numeric_limits<T>::epsilon() * 10`. If you need a different one, 
+/// compare the components by `exma::utils::compare(a, b, tolerance)`.
 /// @param a_vector
 /// @param b_vector
 ///
@@ -0,0 +1,202 @@
+#include "MosquitoNet.h"
+#include "exma2D/fixed.hpp"
+#include "exma2D/vector2D.hpp"
+#include "exma2D/impl/utils.tpp"
+
+#include "exma2D/vendor/degrad/degrad.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace Enhedron::Test;
+using namespace exma::vector;
+using namespace exma::utils;
+using exma::fixed::q16_16;
+
+struct VectorQ
+{
+    q16_16 x, y;
+};
+
+void checkFixedComponents(Check& check, VectorQ a, VectorQ b) {
+    check.when("The respective values of the components should be equal", [&] {
+        check(VAR(compare(a.x, b.x)) && VAR(compare(a.y, b.y)) &&
+            // Just so we can see the values
+            (true || (VAR(static_cast<double>(a.x)) && 
+                      VAR(static_cast<double>(a.y)) &&
+                      VAR(static_cast<double>(b.x)) && 
+                      VAR(static_cast<double>(b.y))))
+        );
+    });
+}
+
+static Suite fixed_suite("fixed-point",
+    context("constexpr",
+        given("constexpr functions", [](auto & check)
+        {
+            constexpr VectorQ vec_a {1, 1};
+            constexpr VectorQ vec_b {5, -3};
+
+            constexpr auto additon = vec_a + vec_b;
+            constexpr auto multiplication = vec_a * 3;
+            constexpr auto division = vec_b / q16_16(.5);
+            constexpr auto dot_product = dot(vec_a, vec_b);
+            constexpr auto cross_product = cross(vec_a, vec_b);
+            constexpr auto projection = project(vec_b, vec_a);
+
+            check("they are computed exactly",
+                VAR(additon.x == 6) && VAR(additon.y == -2) &&
+                VAR(multiplication.x == 3) && VAR(division.x == 10) &&
+                VAR(dot_product == 2) && VAR(cross_product == -8) &&
+                VAR(projection.x == 1) && VAR(projection.y == 1));
+        })
+    ),
+    context("arithmetic",
+        given("fractions", [](auto & check)
+        {
+            check("products and quotients are rounded",
+                VAR(q16_16(1.5) * q16_16(-2.25) == q16_16(-3.375)) &&
+                VAR(q16_16(1) / 3 == q16_16::fromRaw(21845)) &&
+                VAR(sqrt(q16_16(2)) == q16_16::fromRaw(92681)) &&
+                VAR(sqrt(q16_16(-2)) == 0));
+#ifdef __SIZEOF_INT128__
+            using exma::fixed::q32_32;
+            check("the wider format keeps more of the fraction",
+                VAR(q32_32(1) / 3 == q32_32::fromRaw(1431655765)) &&
+                VAR(q32_32(1.5) * q32_32(-2.25) == q32_32(-3.375)));
+#endif
+        }),
+        given("the limits", [](auto & check)
+        {
+            using limits = std::numeric_limits<q16_16>;
+            check("they describe the number as the floating-point types do",
+                VAR(limits::min() == limits::epsilon()) &&
+                VAR(limits::min() > 0) &&
+                VAR(limits::lowest() == q16_16::fromRaw(INT32_MIN)) &&
+                VAR(limits::is_bounded) && VAR(!limits::is_modulo) &&
+                VAR(std::max(limits::digits, limits::digits10) == 31) &&
+                VAR(limits::max_digits10 == 11) &&
+                VAR(limits::round_style == std::round_indeterminate));
+        }),
+        given("overflowing operations", [](auto & check)
+        {
+            using limits = std::numeric_limits<q16_16>;
+            check("they wrap around",
+                VAR(q16_16(40000) == q16_16::fromRaw(-1673527296)) &&
+                VAR(limits::max() + limits::epsilon() == limits::lowest()) &&
+                VAR(limits::lowest() - limits::epsilon() == limits::max()) &&
+                VAR(-limits::lowest() == limits::lowest()));
+        }),
+        given("a division by zero",
+            checkFixedComponents,
+            VectorQ{4, 2} / 0,
+            VectorQ{0, 0})
+    ),
+    context("projecting",
+        given("an axis too short to be squared", [](auto & check)
+        {
+            const VectorQ axis{q16_16::fromRaw(100), 0};
+            const auto projection = project(VectorQ{1, 1}, axis);
+            const auto reflection = reflect(VectorQ{1, 1}, axis);
+            check("no division by zero happens",
+                VAR(projection.x == 0) && VAR(projection.y == 0) &&
+                VAR(reflection.x == 0) && VAR(reflection.y == 0));
+        })
+    ),
+    context("length",
+        given("a 'triangle'", [](auto & check)
+        {
+            check("the hypothenuse is exact",
+                VAR(len(VectorQ{3, 4}) == 5) &&
+                VAR(distance(VectorQ{-3, 4}, VectorQ{0, 0}) == 5));
+        })
+    ),
+    context("rotating",
+        given("axis-aligned rotating",
+            checkFixedComponents,
+            rotate(VectorQ{10, 0},  VectorQ{0, 0}, 90_deg),
+            VectorQ {0, 10}),
+        given("moved origin",
+            checkFixedComponents,
+            rotate(VectorQ{10, 10},  VectorQ{-1, -1}, 180_deg),
+            VectorQ {-12, -12}),
+        given("angles all around", [](auto & check)
+        {
+            double error = 0;
+            for(int i = -2000; i <= 2000; ++i)
+            {
+                const q16_16 angle(i / 100.);
+                const auto exact = static_cast<double>(angle);
+                error = std::fmax(error, std::fabs(
+                    static_cast<double>(exma::fixed::sin(angle)) - 
+                    std::sin(exact)));
+                error = std::fmax(error, std::fabs(
+                    static_cast<double>(exma::fixed::cos(angle)) - 
+                    std::cos(exact)));
+            }
+            check("sine and cosine are precise to the last bit",
+                VAR(error) <= 1. / 65536);
+        })
+    ),
+    context("batch",
+        given("vectors stored as arrays", [](auto & check)
+        {
+            std::vector<q16_16> x, y;
+            for(int i = 0; i < 10000; ++i)
+            {
+                x.push_back(q16_16::fromRaw(i * 977));
+                y.push_back(q16_16::fromRaw(-i * 1313));
+            }
+            auto x_par = x, y_par = y;
+            const VectorQ origin{1, -2};
+
+            exma::fixed::vector_arrays<q16_16> sequenced{
+                x.data(), y.data(), x.size()};
+            exma::fixed::translate(exma::execution::seq, sequenced, origin);
+            exma::fixed::scale(exma::execution::seq, sequenced, q16_16(.75));
+            exma::fixed::rotate(exma::execution::seq, sequenced, origin, 
+                                30_deg);
+
+            exma::fixed::vector_arrays<q16_16> parallel{
+                x_par.data(), y_par.data(), x_par.size()};
+            exma::fixed::translate(exma::execution::par, parallel, origin);
+            exma::fixed::scale(exma::execution::par, parallel, q16_16(.75));
+            exma::fixed::rotate(exma::execution::par, parallel, origin, 
+                                30_deg);
+
+            auto expected = rotate(
+                (VectorQ{q16_16::fromRaw(9999 * 977), 
+                         q16_16::fromRaw(-9999 * 1313)} + origin) * 
+                    q16_16(.75),
+                origin, 30_deg);
+
+            check("they match the single vector functions",
+                VAR(x.back() == expected.x) && VAR(y.back() == expected.y));
+            check("they are the same regardless of the threads",
+                VAR(x == x_par) && VAR(y == y_par));
+        }),
+        given("vectors of floats stored as arrays", [](auto & check)
+        {
+            struct VectorF
+            {
+                float x, y;
+            };
+            float x[] = {1, 2}, y[] = {0, 1};
+            exma::fixed::vector_arrays<float> vectors{x, y, 2};
+            exma::fixed::translate(exma::execution::seq, vectors, 
+                                   VectorF{1, 1});
+            exma::fixed::scale(exma::execution::seq, vectors, 2.f);
+            exma::fixed::rotate(exma::execution::seq, vectors, 
+                                VectorF{0, 0}, 90_deg);
+
+            check("they are transformed as well",
+                VAR(compare(x[0], -2.f, absolute(1e-5f))) && 
+                VAR(compare(y[0], 4.f, absolute(1e-5f))) &&
+                VAR(compare(x[1], -4.f, absolute(1e-5f))) && 
+                VAR(compare(y[1], 6.f, absolute(1e-5f))));
+        })
+    )
+);
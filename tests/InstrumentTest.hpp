@@ -0,0 +1,113 @@
+#include "MosquitoNet.h"
+#include "exma2D/instrument.hpp"
+#include "exma2D/vector2D.hpp"
+#include "exma2D/polyline.hpp"
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Enhedron::Test;
+
+// Only built into the instrumented test executable
+#ifdef EXMA_INSTRUMENT
+
+struct CountedF
+{
+    float x, y;
+};
+
+std::uint64_t callsOf(const char * name)
+{
+    for(const auto & stat : exma::instrument::snapshot())
+        if(std::string(stat.name) == name)
+            return stat.calls;
+    return 0;
+}
+
+static Suite instrument_suite("instrumentation",
+    given("instrumented functions", [](auto & check)
+    {
+        using namespace exma::vector;
+
+        check.when("they are called at compile time", [&]()
+        {
+            exma::instrument::reset();
+            constexpr auto result = dot(CountedF{1, 2}, CountedF{3, 4});
+            check("they are not counted",
+                VAR(result) == 11.f && VAR(callsOf("dot")) == 0u);
+        });
+        check.when("they are called through one another", [&]()
+        {
+            exma::instrument::reset();
+            volatile float factor = 2.f;
+            const auto result = factor * CountedF{1, 2};
+            const bool different = result != CountedF{1, 2};
+
+            check("only the calls made by the user are counted",
+                VAR(different) && 
+                VAR(callsOf("operator*")) == 1u &&
+                VAR(callsOf("operator!=")) == 1u &&
+                VAR(callsOf("operator==")) == 0u);
+        });
+        check.when("they are called in several threads", [&]()
+        {
+            exma::instrument::reset();
+            auto work = []()
+            {
+                volatile float x = 1.f;
+                for(int i = 0; i < 1000; ++i)
+                    len(CountedF{x, 2});
+            };
+            std::thread other(work);
+            work();
+            other.join();
+
+            check("the calls of all the threads are counted",
+                VAR(callsOf("len")) == 2000u &&
+                VAR(callsOf("len2")) == 2000u &&
+                VAR(callsOf("dot")) == 2000u);
+        });
+        check.when("they are called in many short-lived threads", [&]()
+        {
+            exma::instrument::reset();
+            auto registered = []()
+            {
+                std::size_t count = 0;
+                for(auto * thread = exma::instrument::registry().load(); 
+                    thread != nullptr; thread = thread->next)
+                    ++count;
+                return count;
+            };
+            const auto before = registered();
+            for(int i = 0; i < 100; ++i)
+            {
+                std::thread([]() { len(CountedF{3, 4}); }).join();
+            }
+
+            check("the counters of the finished threads are reused",
+                VAR(registered()) <= before + 1 &&
+                VAR(callsOf("len")) == 100u);
+        });
+        check.when("the statistics are dumped", [&]()
+        {
+            exma::instrument::reset();
+            std::vector<CountedF> line{{0, 0}, {1, 1}, {2, 0}};
+            exma::polyline::simplifyRDP(line.begin(), line.end(), .1f);
+
+            std::ostringstream text, json;
+            exma::instrument::dump(text);
+            exma::instrument::dump(json, exma::instrument::format::json);
+            check("they list the called functions",
+                VAR(text.str().find("simplifyRDP: 1 calls") != 
+                    std::string::npos) &&
+                VAR(json.str().find("{\"function\": \"simplifyRDP\", "
+                                    "\"calls\": 1, \"samples\": 1") != 
+                    std::string::npos));
+        });
+    })
+);
+
+#endif
@@ -0,0 +1,154 @@
+#include "MosquitoNet.h"
+#include "exma2D/particles.hpp"
+#include "exma2D/impl/utils.tpp"
+
+#include <cstddef>
+#include <vector>
+
+using namespace Enhedron::Test;
+using namespace exma::particles;
+using namespace exma::utils;
+
+struct ParticleF
+{
+    float x, y;
+};
+
+static Suite particles_suite("particles",
+    context("semi-implicit Euler",
+        given("a falling particle", [](auto & check)
+        {
+            float x[] = {0}, y[] = {10}, vx[] = {1}, vy[] = {0};
+            particle_arrays<float> particles{x, y, vx, vy, 1};
+            integration_parameters<ParticleF> parameters;
+            parameters.dt = .5f;
+            parameters.gravity = {0, -2};
+
+            check.when("it is advanced", [&]()
+            {
+                integrateEuler(exma::execution::seq, particles, parameters);
+                check("the velocity is updated before the position",
+                    VAR(compare(vy[0], -1.f)) &&
+                    VAR(compare(y[0], 9.5f)) &&
+                    VAR(compare(x[0], .5f)));
+            });
+        }),
+        given("a fast particle", [](auto & check)
+        {
+            float x[] = {0}, y[] = {0}, vx[] = {30}, vy[] = {40};
+            particle_arrays<float> particles{x, y, vx, vy, 1};
+            integration_parameters<ParticleF> parameters;
+            parameters.dt = 1;
+            parameters.max_speed = 5;
+
+            check.when("it is advanced", [&]()
+            {
+                integrateEuler(exma::execution::seq, particles, parameters);
+                check("the speed is clamped",
+                    VAR(compare(vx[0], 3.f, absolute(1e-5f))) &&
+                    VAR(compare(vy[0], 4.f, absolute(1e-5f))) &&
+                    VAR(compare(x[0], 3.f, absolute(1e-5f))));
+            });
+        }),
+        given("a particle leaving through a wall", [](auto & check)
+        {
+            float x[] = {.5f}, y[] = {1}, vx[] = {-1}, vy[] = {1};
+            particle_arrays<float> particles{x, y, vx, vy, 1};
+            const wall<ParticleF> walls[] = {{{1, 0}, 0}};
+            integration_parameters<ParticleF> parameters;
+            parameters.dt = 1;
+            parameters.walls = walls;
+            parameters.wall_count = 1;
+
+            check.when("it is advanced", [&]()
+            {
+                integrateEuler(exma::execution::seq, particles, parameters);
+                check("it bounces off",
+                    VAR(compare(x[0], .5f)) && VAR(compare(y[0], 2.f)) &&
+                    VAR(compare(vx[0], 1.f)) && VAR(compare(vy[0], 1.f)));
+            });
+        }),
+        given("many particles", [](auto & check)
+        {
+            const std::size_t count = 10000;
+            std::vector<float> x(count), y(count), vx(count), vy(count);
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                x[i] = static_cast<float>(i % 100);
+                y[i] = static_cast<float>(i / 100);
+                vx[i] = static_cast<float>(i % 7) - 3;
+                vy[i] = static_cast<float>(i % 5) - 2;
+            }
+            auto x_par = x, y_par = y, vx_par = vx, vy_par = vy;
+
+            const wall<ParticleF> walls[] = {
+                {{1, 0}, 0}, {{-1, 0}, -99}, {{0, 1}, 0}, {{0, -1}, -99}
+            };
+            integration_parameters<ParticleF> parameters;
+            parameters.dt = .1f;
+            parameters.gravity = {0, -9.81f};
+            parameters.drag = .5f;
+            parameters.max_speed = 4;
+            parameters.walls = walls;
+            parameters.wall_count = 4;
+
+            check.when("they are advanced in parallel", [&]()
+            {
+                particle_arrays<float> sequenced{
+                    x.data(), y.data(), vx.data(), vy.data(), count};
+                particle_arrays<float> parallel{
+                    x_par.data(), y_par.data(), vx_par.data(), vy_par.data(), 
+                    count};
+                for(int step = 0; step < 10; ++step)
+                {
+                    integrateEuler(exma::execution::seq, sequenced, parameters);
+                    integrateEuler(exma::execution::parallel_policy{4}, 
+                                   parallel, parameters);
+                }
+                check("the results match the sequenced ones",
+                    VAR(x == x_par) && VAR(y == y_par) &&
+                    VAR(vx == vx_par) && VAR(vy == vy_par));
+            });
+        })
+    ),
+    context("Verlet",
+        given("a falling particle", [](auto & check)
+        {
+            float x[] = {0}, y[] = {10}, previous_x[] = {-1}, 
+                  previous_y[] = {10};
+            verlet_arrays<float> particles{x, y, previous_x, previous_y, 1};
+            integration_parameters<ParticleF> parameters;
+            parameters.dt = 1;
+            parameters.gravity = {0, -2};
+
+            check.when("it is advanced", [&]()
+            {
+                integrateVerlet(exma::execution::seq, particles, parameters);
+                check("it keeps its velocity and accelerates",
+                    VAR(compare(x[0], 1.f)) && VAR(compare(y[0], 8.f)) &&
+                    VAR(compare(previous_x[0], 0.f)) &&
+                    VAR(compare(previous_y[0], 10.f)));
+            });
+        }),
+        given("a particle leaving through a wall", [](auto & check)
+        {
+            float x[] = {.5f}, y[] = {1}, previous_x[] = {1.5f}, 
+                  previous_y[] = {0};
+            verlet_arrays<float> particles{x, y, previous_x, previous_y, 1};
+            const wall<ParticleF> walls[] = {{{1, 0}, 0}};
+            integration_parameters<ParticleF> parameters;
+            parameters.dt = 1;
+            parameters.walls = walls;
+            parameters.wall_count = 1;
+
+            check.when("it is advanced", [&]()
+            {
+                integrateVerlet(exma::execution::seq, particles, parameters);
+                check("it bounces off",
+                    VAR(compare(x[0], .5f)) && VAR(compare(y[0], 2.f)) &&
+                    VAR(compare(x[0] - previous_x[0], 1.f)) &&
+                    VAR(compare(y[0] - previous_y[0], 1.f)));
+            });
+        })
+    )
+);
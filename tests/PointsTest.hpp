@@ -0,0 +1,109 @@
+#include "MosquitoNet.h"
+#include "exma2D/points.hpp"
+#include "exma2D/impl/utils.tpp"
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+using namespace Enhedron::Test;
+using namespace exma::points;
+using namespace exma::utils;
+
+struct VertexF
+{
+    float x, y;
+};
+
+struct VertexI
+{
+    int x, y;
+};
+
+using Remap = std::vector<std::size_t>;
+
+static Suite points_suite("points",
+    context("tolerance",
+        given("two numbers", [](auto & check)
+        {
+            check.when("an absolute tolerance is used", [&]()
+            {
+                constexpr auto result_a = compare(1.f, 1.5f, absolute(.5f));
+                constexpr auto result_b = compare(1.f, 1.6f, absolute(.5f));
+                constexpr auto result_c = compare(-3, 3, absolute(6));
+                check("the numbers compare within the tolerance",
+                    VAR(result_a) && !VAR(result_b) && VAR(result_c));
+            });
+            check.when("an ULP tolerance is used", [&]()
+            {
+                const float one = 1.f;
+                const float next = std::nextafter(one, 2.f);
+                const float after_next = std::nextafter(next, 2.f);
+                check("the numbers compare within the tolerance",
+                    VAR(compare(one, next, ulps(1))) &&
+                    !VAR(compare(one, after_next, ulps(1))) &&
+                    VAR(compare(one, after_next, ulps(2))) &&
+                    VAR(compare(-0.f, 0.f, ulps(0))) &&
+                    VAR(compare(1e30, std::nextafter(1e30, 0.), ulps(1))));
+            });
+            check.when("one of them is NaN", [&]()
+            {
+                const auto nan = std::numeric_limits<float>::quiet_NaN();
+                check("they are never the same",
+                    !VAR(compare(nan, nan, ulps(1000))));
+            });
+        })
+    ),
+    context("welding",
+        given("points with near-duplicates", [](auto & check)
+        {
+            std::vector<VertexF> points{
+                {0, 0}, {1, 1}, {0.0001f, -0.0001f}, {5, 5}, {1, 1.00005f}};
+
+            check.when("an absolute tolerance is used", [&]()
+            {
+                auto result = weld(points.begin(), points.end(), 
+                                   absolute(.001f));
+                check("the near-duplicates are welded",
+                    VAR((result == Remap{0, 1, 0, 3, 1})));
+            });
+            check.when("the tolerance is too small", [&]()
+            {
+                auto result = weld(points.begin(), points.end(), 
+                                   absolute(.00001f));
+                check("nothing is welded",
+                    VAR((result == Remap{0, 1, 2, 3, 4})));
+            });
+            check.when("an ULP tolerance is used", [&]()
+            {
+                auto result = weld(points.begin(), points.end(), ulps(1000));
+                check("only the relatively close points are welded",
+                    VAR((result == Remap{0, 1, 2, 3, 1})));
+            });
+        }),
+        given("points across a cell boundary", [](auto & check)
+        {
+            std::vector<VertexF> points{{.999f, 1.999f}, {1.001f, 2.001f}};
+            auto result = weld(points.begin(), points.end(), absolute(.01f));
+            check("they are welded", VAR((result == Remap{0, 0})));
+        }),
+        given("integer points", [](auto & check)
+        {
+            std::vector<VertexI> points{{0, 0}, {3, -3}, {0, 0}, {-2, 1}};
+
+            check.when("the default tolerance is used", [&]()
+            {
+                auto result = weld(points.begin(), points.end());
+                check("only the same points are welded",
+                    VAR((result == Remap{0, 1, 0, 3})));
+            });
+            check.when("an absolute tolerance is used", [&]()
+            {
+                auto result = weld(points.begin(), points.end(), absolute(2));
+                check("the close points are welded",
+                    VAR((result == Remap{0, 1, 0, 0})));
+            });
+        })
+    )
+);
@@ -0,0 +1,153 @@
+#include "MosquitoNet.h"
+#include "exma2D/polyline.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+using namespace Enhedron::Test;
+using namespace exma::polyline;
+
+struct PointF
+{
+    float x, y;
+};
+
+struct PointI
+{
+    int x, y;
+};
+
+using Indices = std::vector<std::size_t>;
+
+static Suite polyline_suite("polylines",
+    context("segment distance",
+        given("a point and a segment", [](auto & check)
+        {
+            constexpr PointF a{0, 0};
+            constexpr PointF b{10, 0};
+
+            check.when("the point lies next to the segment", [&]()
+            {
+                constexpr auto result = segmentDistance2(PointF{5, 3}, a, b);
+                check("the squared perpendicular distance is returned",
+                    VAR(result) == 9.f);
+            });
+            check.when("the point lies beyond an endpoint", [&]()
+            {
+                auto result_a = segmentDistance2(PointF{-3, 4}, a, b);
+                auto result_b = segmentDistance2(PointF{13, -4}, a, b);
+                check("the squared distance to the endpoint is returned",
+                    VAR(result_a) == 25.f && VAR(result_b) == 25.f);
+            });
+            check.when("the components are integers", [&]()
+            {
+                auto result = segmentDistance2(PointI{5, 1}, PointI{0, 0}, 
+                                               PointI{10, 0});
+                check("the squared perpendicular distance is returned",
+                    VAR(result) == 1);
+            });
+            check.when("the segment is degenerated", [&]()
+            {
+                auto result = segmentDistance2(PointF{3, 4}, a, a);
+                check("the squared distance to the endpoint is returned",
+                    VAR(result) == 25.f);
+            });
+        })
+    ),
+    context("Ramer-Douglas-Peucker",
+        given("a short polyline", [](auto & check)
+        {
+            std::vector<PointF> line{{0, 0}, {1, 1}};
+            auto result = simplifyRDP(line.begin(), line.end(), 10.f);
+            check("all the points are kept", VAR((result == Indices{0, 1})));
+        }),
+        given("a polyline with a small bump", [](auto & check)
+        {
+            std::vector<PointF> line{{0, 0}, {1, .1f}, {2, 0}, {3, 5}, {4, 0}};
+
+            check.when("the tolerance is bigger than the bump", [&]()
+            {
+                auto result = simplifyRDP(line.begin(), line.end(), .5f);
+                check("the bump is dropped", 
+                    VAR((result == Indices{0, 2, 3, 4})));
+            });
+            check.when("the tolerance is smaller than the bump", [&]()
+            {
+                auto result = simplifyRDP(line.begin(), line.end(), .05f);
+                check("all the points are kept",
+                    VAR((result == Indices{0, 1, 2, 3, 4})));
+            });
+        }),
+        given("a polyline with integer coordinates", [](auto & check)
+        {
+            std::vector<PointI> line{{0, 0}, {5, 1}, {10, 0}, {15, 8}, 
+                                     {20, 0}, {15000, 2}, {30000, 0}};
+
+            check.when("the tolerance is bigger than the small bumps", [&]()
+            {
+                auto result = simplifyRDP(line.begin(), line.end(), 2);
+                check("they are dropped", 
+                    VAR((result == Indices{0, 2, 3, 4, 6})));
+            });
+            check.when("the tolerance is smaller than the bumps", [&]()
+            {
+                auto result = simplifyRDP(line.begin(), line.end(), 0.5);
+                check("all the points are kept",
+                    VAR((result == Indices{0, 1, 2, 3, 4, 5, 6})));
+            });
+        }),
+        given("a long straight polyline", [](auto & check)
+        {
+            std::vector<PointF> line;
+            for(int i = 0; i < 100000; ++i)
+                line.push_back({static_cast<float>(i), 0});
+            auto result = simplifyRDP(line.begin(), line.end(), .1f);
+            check("only the endpoints are kept",
+                VAR((result == Indices{0, 99999})));
+        })
+    ),
+    context("Visvalingam-Whyatt",
+        given("a polyline with a small bump", [](auto & check)
+        {
+            std::vector<PointF> line{{0, 0}, {1, .1f}, {2, 0}, {3, 5}, {4, 0}};
+
+            check.when("the area is bigger than the bump", [&]()
+            {
+                auto result = simplifyVW(line.begin(), line.end(), 1.f);
+                check("the bump is dropped", 
+                    VAR((result == Indices{0, 2, 3, 4})));
+            });
+            check.when("the area is smaller than the bump", [&]()
+            {
+                auto result = simplifyVW(line.begin(), line.end(), .01f);
+                check("all the points are kept",
+                    VAR((result == Indices{0, 1, 2, 3, 4})));
+            });
+        })
+    ),
+    context("batch",
+        given("several polylines", [](auto & check)
+        {
+            std::vector<std::vector<PointF>> lines{
+                {{0, 0}, {1, .1f}, {2, 0}, {3, 5}, {4, 0}},
+                {{0, 0}, {1, 0}, {2, 0}},
+                {{0, 0}}
+            };
+
+            check.when("they are simplified in parallel", [&]()
+            {
+                auto sequenced = simplifyRDP(exma::execution::seq, lines, .5f);
+                auto parallel = simplifyRDP(
+                    exma::execution::parallel_policy{4}, lines, .5f);
+                auto parallel_vw = simplifyVW(exma::execution::par, lines, 1.f);
+                check("the results match the sequenced ones",
+                    VAR(sequenced == parallel) &&
+                    VAR((parallel[0] == Indices{0, 2, 3, 4})) &&
+                    VAR((parallel[1] == Indices{0, 2})) &&
+                    VAR((parallel[2] == Indices{0})) &&
+                    VAR((parallel_vw[0] == Indices{0, 2, 3, 4})));
+            });
+        })
+    )
+);
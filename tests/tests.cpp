@@ -1,6 +1,11 @@
 #include "MosquitoNet.h"
 
 #include "VectorTest.hpp"
+#include "PolylineTest.hpp"
+#include "PointsTest.hpp"
+#include "ParticlesTest.hpp"
+#include "FixedTest.hpp"
+#include "InstrumentTest.hpp"
 
 int main(int argc, const char* argv[]) {
     return Enhedron::Test::run(argc, argv);